@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui xml
+QT       += core gui xml concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -46,6 +46,7 @@ SOURCES += \
     src/ui/ProjectManager.cpp \
     src/ui/CEGUIWidget.cpp \
     src/ui/CEGUIGraphicsView.cpp \
+    src/ui/CEGUIFrameScheduler.cpp \
     src/ui/CEGUIGraphicsScene.cpp \
     src/ui/dialogs/NewProjectDialog.cpp \
     src/ui/dialogs/ProjectSettingsDialog.cpp \
@@ -61,6 +62,7 @@ SOURCES += \
     src/ui/dialogs/MultiplePossibleFactoriesDialog.cpp \
     src/ui/dialogs/SettingsDialog.cpp \
     src/ui/widgets/ColourButton.cpp \
+    src/ui/widgets/FrameProfilerWidget.cpp \
     src/ui/widgets/PenButton.cpp \
     src/ui/dialogs/PenDialog.cpp \
     src/ui/widgets/KeySequenceButton.cpp \
@@ -71,6 +73,17 @@ SOURCES += \
     src/cegui/CEGUIProject.cpp \
     src/cegui/CEGUIProjectItem.cpp \
     src/cegui/CEGUIManipulator.cpp \
+    src/cegui/CEGUIResourceTracker.cpp \
+    src/cegui/CEGUIResourceCache.cpp \
+    src/cegui/CEGUITextureDecoder.cpp \
+    src/cegui/CEGUIProjectSyncJob.cpp \
+    src/cegui/CEGUISyncTimings.cpp \
+    src/cegui/CEGUIRenderTargetManager.cpp \
+    src/cegui/CEGUIFrameProfiler.cpp \
+    src/cegui/CEGUIPixelReadback.cpp \
+    src/cegui/CEGUIPropertyBridge.cpp \
+    src/cegui/CEGUIPropertySchema.cpp \
+    src/cegui/CEGUIDependencyGraph.cpp \
     src/cegui/QtnPropertyUDim.cpp \
     src/cegui/QtnPropertyUVector2.cpp \
     src/cegui/QtnPropertyUVector3.cpp \
@@ -83,6 +96,7 @@ SOURCES += \
     src/Application.cpp \
     src/util/RecentlyUsed.cpp \
     src/util/Settings.cpp \
+    src/util/SettingsHandle.cpp \
     src/util/SettingsCategory.cpp \
     src/util/SettingsSection.cpp \
     src/util/SettingsEntry.cpp \
@@ -95,6 +109,8 @@ SOURCES += \
     src/editors/layout/LayoutCodeMode.cpp \
     src/editors/imageset/ImagesetCodeMode.cpp \
     src/editors/layout/LayoutPreviewerMode.cpp \
+    src/editors/layout/LayoutMultiPreviewMode.cpp \
+    src/editors/layout/LayoutScreenshotExporter.cpp \
     src/editors/imageset/ImagesetVisualMode.cpp \
     src/ui/imageset/ImagesetEditorDockWidget.cpp \
     src/ui/ResizableGraphicsView.cpp \
@@ -139,11 +155,23 @@ HEADERS += \
     src/ui/MainWindow.h \
     src/ui/CEGUIWidget.h \
     src/ui/CEGUIGraphicsView.h \
+    src/ui/CEGUIFrameScheduler.h \
     src/ui/CEGUIGraphicsScene.h \
     src/cegui/CEGUIManager.h \
     src/cegui/CEGUIProject.h \
     src/cegui/CEGUIProjectItem.h \
     src/cegui/CEGUIManipulator.h \
+    src/cegui/CEGUIResourceTracker.h \
+    src/cegui/CEGUIResourceCache.h \
+    src/cegui/CEGUITextureDecoder.h \
+    src/cegui/CEGUIProjectSyncJob.h \
+    src/cegui/CEGUISyncTimings.h \
+    src/cegui/CEGUIRenderTargetManager.h \
+    src/cegui/CEGUIFrameProfiler.h \
+    src/cegui/CEGUIPixelReadback.h \
+    src/cegui/CEGUIPropertyBridge.h \
+    src/cegui/CEGUIPropertySchema.h \
+    src/cegui/CEGUIDependencyGraph.h \
     src/cegui/QtnPropertyUDim.h \
     src/cegui/QtnPropertyUVector2.h \
     src/cegui/QtnPropertyUVector3.h \
@@ -168,11 +196,13 @@ HEADERS += \
     src/util/RecentlyUsed.h \
     src/ui/dialogs/SettingsDialog.h \
     src/util/Settings.h \
+    src/util/SettingsHandle.h \
     src/util/SettingsCategory.h \
     src/util/SettingsSection.h \
     src/util/SettingsEntry.h \
     src/ui/SettingEntryEditors.h \
     src/ui/widgets/ColourButton.h \
+    src/ui/widgets/FrameProfilerWidget.h \
     src/ui/widgets/PenButton.h \
     src/ui/dialogs/PenDialog.h \
     src/ui/widgets/KeySequenceButton.h \
@@ -188,6 +218,8 @@ HEADERS += \
     src/editors/layout/LayoutCodeMode.h \
     src/editors/imageset/ImagesetCodeMode.h \
     src/editors/layout/LayoutPreviewerMode.h \
+    src/editors/layout/LayoutMultiPreviewMode.h \
+    src/editors/layout/LayoutScreenshotExporter.h \
     src/editors/imageset/ImagesetVisualMode.h \
     src/ui/imageset/ImagesetEditorDockWidget.h \
     src/ui/ResizableGraphicsView.h \
@@ -213,6 +213,34 @@ void Application::createSettingsEntries()
                                   "colour", false, 4));
     secBG->addEntry(std::move(entry));
 
+    auto secRendering = catCEGUI->createSection("rendering", "Rendering");
+
+    entry.reset(new SettingsEntry(*secRendering, "frame_rate", 60, "Continuous rendering frame rate",
+                                  "How many times per second views with continuous rendering (e.g. live preview)\n"
+                                  "are redrawn. Views that are hidden, minimized or covered are never redrawn.",
+                                  "int", false, 1));
+    secRendering->addEntry(std::move(entry));
+
+    entry.reset(new SettingsEntry(*secRendering, "offscreen_budget", 512, "Offscreen buffer budget (MB)",
+                                  "GPU memory for rendered CEGUI contents of open editor tabs. When exceeded,\n"
+                                  "buffers of tabs not currently shown are released, least recently rendered\n"
+                                  "first, and rendered again when shown. 0 means no limit.",
+                                  "int", false, 2));
+    secRendering->addEntry(std::move(entry));
+
+    entry.reset(new SettingsEntry(*secRendering, "interaction_interval", 50, "Refresh interval while interacting (ms)",
+                                  "While widgets are dragged or resized and while the view is zoomed or panned,\n"
+                                  "CEGUI contents are rendered at most this often. Selection frames and other\n"
+                                  "editor items still follow the mouse at full rate. 0 renders every frame.",
+                                  "int", false, 3));
+    secRendering->addEntry(std::move(entry));
+
+    entry.reset(new SettingsEntry(*secRendering, "interaction_idle_delay", 200, "Interaction end delay (ms)",
+                                  "Time without mouse dragging or wheel events after which an interaction is\n"
+                                  "considered finished and CEGUI contents are rendered on every change again.",
+                                  "int", false, 4));
+    secRendering->addEntry(std::move(entry));
+
     auto secScreenshots = catCEGUI->createSection("screenshots", "Screenshots");
 
     entry.reset(new SettingsEntry(*secScreenshots, "save", true, "Save to file",
@@ -241,6 +269,29 @@ void Application::createSettingsEntries()
 
     secScreenshots->addEntry(std::move(entry));
 
+    auto secResources = catCEGUI->createSection("resources", "Project resources");
+
+    entry.reset(new SettingsEntry(*secResources, "incremental_reload", true, "Incremental resource reload",
+                                  "'Reload resources' rebuilds only schemes, imagesets, fonts and looknfeels\n"
+                                  "whose files were changed since the last synchronisation. Disable to\n"
+                                  "always purge and recreate all project resources.",
+                                  "checkbox", false, 1));
+    secResources->addEntry(std::move(entry));
+
+    entry.reset(new SettingsEntry(*secResources, "disk_cache", true, "Cache decoded resources on disk",
+                                  "Keeps decoded textures and parsed resource descriptions of each project\n"
+                                  "in the user cache directory, so that unchanged files load faster the\n"
+                                  "next time the project is opened.",
+                                  "checkbox", false, 2));
+    secResources->addEntry(std::move(entry));
+
+    entry.reset(new SettingsEntry(*secResources, "lazy_loading", false, "Load resources on demand",
+                                  "Registers widget types of project schemes without loading their imagesets,\n"
+                                  "fonts and looknfeels. Each of them is loaded when a layout or a new widget\n"
+                                  "needs it for the first time. Speeds up opening of big projects.",
+                                  "checkbox", false, 3));
+    secResources->addEntry(std::move(entry));
+
     ImagesetEditor::createSettings(*_settings);
     LayoutEditor::createSettings(*_settings);
     LookNFeelEditor::createSettings(*_settings);
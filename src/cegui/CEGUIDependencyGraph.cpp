@@ -0,0 +1,521 @@
+#include "src/cegui/CEGUIDependencyGraph.h"
+#include "src/cegui/CEGUIProject.h"
+#include "qxmlstream.h"
+#include "qdiriterator.h"
+#include "qfileinfo.h"
+#include "qdatetime.h"
+#include <QtConcurrent/qtconcurrentrun.h>
+
+static const QStringList RESOURCE_GROUPS = { "schemes", "imagesets", "fonts", "looknfeels", "layouts" };
+static const QStringList SCANNED_FILE_PATTERNS = { "*.scheme", "*.imageset", "*.font", "*.looknfeel", "*.layout" };
+
+typedef QHash<QString, QString> GroupDirectories;
+
+static GroupDirectories getGroupDirectories(const CEGUIProject& project)
+{
+    GroupDirectories dirs;
+    for (const auto& group : RESOURCE_GROUPS)
+        dirs.insert(group, QDir::cleanPath(project.getResourceFilePath("", group)));
+    return dirs;
+}
+
+static qint64 getLastModified(const QString& filePath)
+{
+    QFileInfo info(filePath);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+static QString resolveFile(const GroupDirectories& dirs, const QXmlStreamAttributes& attrs, const QString& fileAttr, const QString& defaultGroup)
+{
+    const QString fileName = attrs.value(fileAttr).toString();
+    if (fileName.isEmpty()) return QString();
+
+    QString group = attrs.value("resourceGroup").toString();
+    if (group.isEmpty()) group = defaultGroup;
+
+    return QDir::cleanPath(QDir(dirs.value(group)).filePath(fileName));
+}
+
+// Runs in a worker thread. Values that may name objects are recorded as raw '?value' edges and
+// resolved when all definitions are known, so no knowledge of property types is required.
+static CEGUIDependencyGraph::ScannedFile scanFile(const QString& filePath, qint64 lastModified, const GroupDirectories& dirs)
+{
+    typedef CEGUIDependencyGraph Graph;
+
+    Graph::ScannedFile scanned;
+    scanned.lastModified = lastModified;
+
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly)) return scanned;
+
+    const QString suffix = QFileInfo(filePath).suffix();
+    const QString self = Graph::fileNode(filePath);
+
+    QSet<QString> rawValues; // User node and value, to skip duplicates
+    auto addRawValue = [&scanned, &rawValues](const QString& user, const QString& value)
+    {
+        const QString trimmedValue = value.trimmed();
+        if (trimmedValue.isEmpty() || trimmedValue.at(0).isDigit()) return;
+
+        const QString edgeKey = user + '\n' + trimmedValue;
+        if (rawValues.contains(edgeKey)) return;
+        rawValues.insert(edgeKey);
+        scanned.edges.emplace_back(user, '?' + trimmedValue);
+    };
+
+    QString imagesetName;
+    QString currentLook;
+
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd())
+    {
+        const auto token = xml.readNext();
+        if (token == QXmlStreamReader::Characters)
+        {
+            if (xml.isWhitespace()) continue;
+
+            if (suffix == "layout")
+                addRawValue(self, xml.text().toString());
+            else if (!currentLook.isEmpty())
+                addRawValue(Graph::lookNode(currentLook), xml.text().toString());
+        }
+        else if (token == QXmlStreamReader::EndElement)
+        {
+            if (xml.name() == "WidgetLook") currentLook.clear();
+        }
+        else if (token == QXmlStreamReader::StartElement)
+        {
+            const auto name = xml.name();
+            const auto attrs = xml.attributes();
+
+            if (suffix == "layout")
+            {
+                for (const auto& attr : attrs)
+                    addRawValue(self, attr.value().toString());
+            }
+            else if (suffix == "looknfeel")
+            {
+                if (name == "WidgetLook")
+                {
+                    currentLook = attrs.value("name").toString();
+                    scanned.definitions.append(Graph::lookNode(currentLook));
+                }
+
+                if (!currentLook.isEmpty())
+                    for (const auto& attr : attrs)
+                        if (attr.name() != "name" || name != "WidgetLook")
+                            addRawValue(Graph::lookNode(currentLook), attr.value().toString());
+            }
+            else if (suffix == "imageset")
+            {
+                if (name == "Imageset")
+                {
+                    imagesetName = attrs.value("name").toString();
+                    scanned.definitions.append(Graph::imagesetNode(imagesetName));
+
+                    const QString imageFile = resolveFile(dirs, attrs, "imagefile", "imagesets");
+                    if (!imageFile.isEmpty())
+                    {
+                        scanned.edges.emplace_back(self, Graph::fileNode(imageFile));
+                        scanned.referencedFiles.insert(imageFile, getLastModified(imageFile));
+                    }
+                }
+                else if (name == "Image" && !imagesetName.isEmpty())
+                {
+                    const QString imageNode = Graph::imageNode(imagesetName + '/' + attrs.value("name").toString());
+                    scanned.definitions.append(imageNode);
+                    scanned.edges.emplace_back(imageNode, Graph::imagesetNode(imagesetName));
+                }
+            }
+            else if (suffix == "font")
+            {
+                if (name == "Font")
+                {
+                    scanned.definitions.append(Graph::fontNode(attrs.value("name").toString()));
+
+                    const QString fontFile = resolveFile(dirs, attrs, "filename", "fonts");
+                    if (!fontFile.isEmpty())
+                    {
+                        scanned.edges.emplace_back(self, Graph::fileNode(fontFile));
+                        scanned.referencedFiles.insert(fontFile, getLastModified(fontFile));
+                    }
+                }
+            }
+            else if (suffix == "scheme")
+            {
+                if (name == "Imageset")
+                    scanned.supplies.append(Graph::fileNode(resolveFile(dirs, attrs, "filename", "imagesets")));
+                else if (name == "Font")
+                    scanned.supplies.append(Graph::fileNode(resolveFile(dirs, attrs, "filename", "fonts")));
+                else if (name == "LookNFeel")
+                    scanned.supplies.append(Graph::fileNode(resolveFile(dirs, attrs, "filename", "looknfeels")));
+                else if (name == "ImageFileImageset")
+                {
+                    // Such an imageset consists of a single image named after it
+                    const QString imagesetNode = Graph::imagesetNode(attrs.value("name").toString());
+                    const QString imageNode = Graph::imageNode(attrs.value("name").toString());
+                    scanned.definitions.append(imagesetNode);
+                    scanned.definitions.append(imageNode);
+                    scanned.edges.emplace_back(imageNode, imagesetNode);
+
+                    const QString imageFile = resolveFile(dirs, attrs, "filename", "imagesets");
+                    if (!imageFile.isEmpty())
+                    {
+                        scanned.edges.emplace_back(imagesetNode, Graph::fileNode(imageFile));
+                        scanned.referencedFiles.insert(imageFile, getLastModified(imageFile));
+                    }
+                }
+                else if (name == "FalagardMapping")
+                {
+                    const QString typeNode = Graph::typeNode(attrs.value("windowType").toString());
+                    scanned.definitions.append(typeNode);
+                    scanned.edges.emplace_back(typeNode, Graph::lookNode(attrs.value("lookNFeel").toString()));
+                }
+                else if (name == "WindowAlias")
+                {
+                    const QString typeNode = Graph::typeNode(attrs.value("alias").toString());
+                    scanned.definitions.append(typeNode);
+                    addRawValue(typeNode, attrs.value("target").toString());
+                }
+            }
+        }
+    }
+
+    return scanned;
+}
+
+// Runs in a worker thread
+static CEGUIDependencyGraph::ScannedFiles scanProject(const GroupDirectories& dirs, const CEGUIDependencyGraph::ScannedFiles& previous)
+{
+    CEGUIDependencyGraph::ScannedFiles result;
+
+    QSet<QString> scannedDirs;
+    for (const auto& dir : dirs)
+    {
+        if (dir.isEmpty() || scannedDirs.contains(dir)) continue;
+        scannedDirs.insert(dir);
+
+        QDirIterator it(dir, SCANNED_FILE_PATTERNS, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            const QString filePath = QDir::cleanPath(it.next());
+            if (result.contains(filePath)) continue;
+
+            const qint64 lastModified = it.fileInfo().lastModified().toMSecsSinceEpoch();
+            auto prevIt = previous.constFind(filePath);
+            if (prevIt != previous.cend() && prevIt.value().lastModified == lastModified)
+            {
+                // Referenced files may have changed alone, remember their current state
+                auto scanned = prevIt.value();
+                for (auto refIt = scanned.referencedFiles.begin(); refIt != scanned.referencedFiles.end(); ++refIt)
+                    refIt.value() = getLastModified(refIt.key());
+                result.insert(filePath, scanned);
+            }
+            else
+            {
+                result.insert(filePath, scanFile(filePath, lastModified, dirs));
+            }
+        }
+    }
+
+    return result;
+}
+
+CEGUIDependencyGraph::CEGUIDependencyGraph(QObject* parent)
+    : QObject(parent)
+{
+    connect(&_scanWatcher, &QFutureWatcher<ScannedFiles>::finished, this, &CEGUIDependencyGraph::onScanFinished);
+}
+
+CEGUIDependencyGraph::~CEGUIDependencyGraph()
+{
+    _scanWatcher.waitForFinished();
+}
+
+// Starts updating the graph in background, files not changed since the previous scan are reused
+void CEGUIDependencyGraph::scan(const CEGUIProject& project)
+{
+    waitForScan();
+
+    const GroupDirectories dirs = getGroupDirectories(project);
+    const ScannedFiles previous = _files;
+    _scanWatcher.setFuture(QtConcurrent::run([dirs, previous]()
+    {
+        return scanProject(dirs, previous);
+    }));
+}
+
+void CEGUIDependencyGraph::clear()
+{
+    _scanWatcher.waitForFinished();
+    _scanWatcher.setFuture(QFuture<ScannedFiles>());
+
+    _files.clear();
+    _uses.clear();
+    _usedBy.clear();
+    _suppliedBy.clear();
+    _ready = false;
+}
+
+void CEGUIDependencyGraph::onScanFinished()
+{
+    if (_scanWatcher.isCanceled() || _scanWatcher.future().resultCount() < 1) return;
+
+    _files = _scanWatcher.result();
+    _scanWatcher.setFuture(QFuture<ScannedFiles>());
+
+    rebuildEdges();
+    _ready = true;
+
+    emit updated();
+}
+
+// Queries are answered from the latest data, a scan in progress is waited for.
+// The watcher holds a canceled empty future when there is no scan to wait for.
+void CEGUIDependencyGraph::waitForScan()
+{
+    if (_scanWatcher.isCanceled()) return;
+
+    _scanWatcher.waitForFinished();
+    onScanFinished();
+}
+
+void CEGUIDependencyGraph::rebuildEdges()
+{
+    _uses.clear();
+    _usedBy.clear();
+    _suppliedBy.clear();
+
+    QSet<QString> definedNodes;
+    for (const auto& scanned : _files)
+        for (const auto& node : scanned.definitions)
+            definedNodes.insert(node);
+
+    auto addEdge = [this](const QString& user, const QString& used)
+    {
+        _uses[user].insert(used);
+        _usedBy[used].insert(user);
+    };
+
+    for (auto it = _files.cbegin(); it != _files.cend(); ++it)
+    {
+        const QString self = fileNode(it.key());
+
+        for (const auto& node : it.value().definitions)
+            addEdge(node, self);
+
+        for (const auto& supplied : it.value().supplies)
+            _suppliedBy[supplied].insert(self);
+
+        for (const auto& edge : it.value().edges)
+        {
+            if (!edge.second.startsWith('?'))
+            {
+                addEdge(edge.first, edge.second);
+                continue;
+            }
+
+            // A raw value is linked to every object it could name
+            const QString value = edge.second.mid(1);
+            QStringList candidates = { lookNode(value), typeNode(value), fontNode(value), imageNode(value) };
+            const int sepPos = value.indexOf('/');
+            if (sepPos > 0) candidates.append(imagesetNode(value.left(sepPos)));
+
+            for (const auto& candidate : candidates)
+                if (definedNodes.contains(candidate))
+                    addEdge(edge.first, candidate);
+        }
+    }
+}
+
+// All nodes that use any of the given nodes, directly or through other nodes
+QSet<QString> CEGUIDependencyGraph::collectUsers(const QStringList& nodes) const
+{
+    QSet<QString> users;
+    QStringList queue = nodes;
+    while (!queue.isEmpty())
+    {
+        const QString node = queue.takeLast();
+        auto it = _usedBy.constFind(node);
+        if (it == _usedBy.cend()) continue;
+
+        for (const auto& user : it.value())
+        {
+            if (users.contains(user)) continue;
+            users.insert(user);
+            queue.append(user);
+        }
+    }
+
+    return users;
+}
+
+// Files added, removed or modified since the last scan
+QStringList CEGUIDependencyGraph::getChangedFiles(const CEGUIProject& project)
+{
+    waitForScan();
+
+    QStringList changedFiles;
+    QSet<QString> existingFiles;
+
+    QSet<QString> scannedDirs;
+    for (const auto& dir : getGroupDirectories(project))
+    {
+        if (dir.isEmpty() || scannedDirs.contains(dir)) continue;
+        scannedDirs.insert(dir);
+
+        QDirIterator it(dir, SCANNED_FILE_PATTERNS, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            const QString filePath = QDir::cleanPath(it.next());
+            existingFiles.insert(filePath);
+
+            auto fileIt = _files.constFind(filePath);
+            if (fileIt == _files.cend() || fileIt.value().lastModified != it.fileInfo().lastModified().toMSecsSinceEpoch())
+                changedFiles.append(filePath);
+        }
+    }
+
+    for (auto it = _files.cbegin(); it != _files.cend(); ++it)
+    {
+        if (!existingFiles.contains(it.key()))
+            changedFiles.append(it.key());
+
+        // Images and font files referenced by descriptors aren't scanned, but changes in them matter too
+        const auto& referencedFiles = it.value().referencedFiles;
+        for (auto refIt = referencedFiles.cbegin(); refIt != referencedFiles.cend(); ++refIt)
+            if (getLastModified(refIt.key()) != refIt.value() && !changedFiles.contains(refIt.key()))
+                changedFiles.append(refIt.key());
+    }
+
+    return changedFiles;
+}
+
+// Files that must be reloaded when given files change, changed files themselves are not included.
+// A change of the scheme file or of an image it references directly reloads the whole scheme, and
+// with it everything defined by descriptor files it supplies.
+QStringList CEGUIDependencyGraph::getAffectedFiles(const QStringList& changedFiles)
+{
+    waitForScan();
+
+    QStringList seeds;
+    for (const auto& filePath : changedFiles)
+        seeds.append(fileNode(filePath));
+
+    for (auto it = _files.cbegin(); it != _files.cend(); ++it)
+    {
+        if (!it.key().endsWith(".scheme")) continue;
+
+        bool schemeReloaded = changedFiles.contains(it.key());
+        for (auto refIt = it.value().referencedFiles.cbegin(); !schemeReloaded && refIt != it.value().referencedFiles.cend(); ++refIt)
+            schemeReloaded = changedFiles.contains(refIt.key());
+
+        if (schemeReloaded)
+        {
+            seeds.append(fileNode(it.key()));
+            seeds.append(it.value().supplies);
+        }
+    }
+
+    QStringList affectedFiles;
+    for (const auto& node : collectUsers(seeds))
+        if (node.startsWith("file:") && !changedFiles.contains(node.mid(5)))
+            affectedFiles.append(node.mid(5));
+
+    return affectedFiles;
+}
+
+// Layouts and looknfeels using anything the file defines
+QStringList CEGUIDependencyGraph::findUsages(const QString& filePath)
+{
+    waitForScan();
+
+    QSet<QString> usingFiles;
+    const QString cleanFilePath = QDir::cleanPath(filePath);
+    for (const auto& node : collectUsers({ fileNode(cleanFilePath) }))
+    {
+        if (node.startsWith("file:"))
+        {
+            usingFiles.insert(node.mid(5));
+        }
+        else if (node.startsWith("look:"))
+        {
+            // Looks are reported by files they are defined in
+            for (const auto& used : _uses.value(node))
+                if (used.startsWith("file:"))
+                    usingFiles.insert(used.mid(5));
+        }
+    }
+
+    usingFiles.remove(cleanFilePath);
+
+    QStringList result(usingFiles.begin(), usingFiles.end());
+    result.sort();
+    return result;
+}
+
+// Widget looks, imagesets, images and fonts which no project layout uses even indirectly,
+// as names followed by the kind of the asset, ready to be shown to the user
+QStringList CEGUIDependencyGraph::findUnusedAssets()
+{
+    waitForScan();
+
+    QSet<QString> usedNodes;
+    QStringList queue;
+    for (auto it = _files.cbegin(); it != _files.cend(); ++it)
+        if (it.key().endsWith(".layout"))
+            queue.append(fileNode(it.key()));
+
+    while (!queue.isEmpty())
+    {
+        const QString node = queue.takeLast();
+        for (const auto& used : _uses.value(node))
+        {
+            if (usedNodes.contains(used)) continue;
+            usedNodes.insert(used);
+            queue.append(used);
+        }
+    }
+
+    static const std::pair<QString, QString> assetKinds[] =
+    {
+        { lookNode(QString()), "widget look" },
+        { imagesetNode(QString()), "imageset" },
+        { imageNode(QString()), "image" },
+        { fontNode(QString()), "font" }
+    };
+
+    QStringList unusedAssets;
+    for (const auto& scanned : _files)
+    {
+        for (const auto& node : scanned.definitions)
+        {
+            if (usedNodes.contains(node)) continue;
+
+            for (const auto& kind : assetKinds)
+            {
+                if (node.startsWith(kind.first))
+                {
+                    unusedAssets.append(QString("%1 (%2)").arg(node.mid(kind.first.size()), kind.second));
+                    break;
+                }
+            }
+        }
+    }
+
+    unusedAssets.sort();
+    return unusedAssets;
+}
+
+// Schemes listing the descriptor file or the descriptor file defining the given object
+QStringList CEGUIDependencyGraph::getSupplyingSchemes(const QString& filePath)
+{
+    waitForScan();
+
+    QStringList schemes;
+    for (const auto& node : _suppliedBy.value(fileNode(QDir::cleanPath(filePath))))
+        schemes.append(node.mid(5));
+
+    schemes.sort();
+    return schemes;
+}
@@ -0,0 +1,79 @@
+#ifndef CEGUIDEPENDENCYGRAPH_H
+#define CEGUIDEPENDENCYGRAPH_H
+
+#include "qobject.h"
+#include "qstringlist.h"
+#include "qhash.h"
+#include "qset.h"
+#include "qfuturewatcher.h"
+#include "qdir.h"
+#include <vector>
+
+// Which project files and CEGUI objects depend on which. Nodes are files and named objects (widget
+// looks, window types, imagesets, images and fonts), edges lead from a user to what it uses. Layouts
+// use widget types, looks, images and fonts, looks use each other, objects use files defining them.
+// Schemes supply descriptor files but don't depend on them, otherwise a change of any resource would
+// affect every user of the scheme. Project files are scanned with a streaming XML reader in a worker
+// thread, unchanged files are not read again. Queries never touch the disk.
+
+class CEGUIProject;
+
+class CEGUIDependencyGraph : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    // Everything found in one file
+    struct ScannedFile
+    {
+        qint64 lastModified = 0;
+        QStringList definitions; // Nodes this file defines, each of them uses the file
+        QStringList supplies; // Descriptor files a scheme lists
+        QHash<QString, qint64> referencedFiles; // Images and font files, they aren't scanned themselves
+        std::vector<std::pair<QString, QString>> edges; // User and used, used may be a raw value to be resolved
+    };
+
+    typedef QHash<QString, ScannedFile> ScannedFiles; // By absolute path
+
+    static QString fileNode(const QString& filePath) { return "file:" + filePath; }
+    static QString lookNode(const QString& name) { return "look:" + name; }
+    static QString typeNode(const QString& name) { return "type:" + name; }
+    static QString imagesetNode(const QString& name) { return "imageset:" + name; }
+    static QString imageNode(const QString& name) { return "image:" + name; }
+    static QString fontNode(const QString& name) { return "font:" + name; }
+
+    explicit CEGUIDependencyGraph(QObject* parent = nullptr);
+    virtual ~CEGUIDependencyGraph() override;
+
+    void scan(const CEGUIProject& project);
+    void clear();
+    bool isReady() const { return _ready; }
+    bool isKnownFile(const QString& filePath) const { return _files.contains(QDir::cleanPath(filePath)); }
+
+    QStringList getChangedFiles(const CEGUIProject& project);
+    QStringList getAffectedFiles(const QStringList& changedFiles);
+    QStringList findUsages(const QString& filePath);
+    QStringList findUnusedAssets();
+    QStringList getSupplyingSchemes(const QString& filePath);
+
+signals:
+
+    void updated();
+
+protected:
+
+    void onScanFinished();
+    void waitForScan();
+    void rebuildEdges();
+    QSet<QString> collectUsers(const QStringList& nodes) const;
+
+    ScannedFiles _files;
+    QHash<QString, QSet<QString>> _uses;
+    QHash<QString, QSet<QString>> _usedBy;
+    QHash<QString, QSet<QString>> _suppliedBy; // Descriptor file node to scheme file nodes
+    QFutureWatcher<ScannedFiles> _scanWatcher;
+    bool _ready = false;
+};
+
+#endif // CEGUIDEPENDENCYGRAPH_H
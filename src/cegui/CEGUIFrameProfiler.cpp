@@ -0,0 +1,108 @@
+#include "src/cegui/CEGUIFrameProfiler.h"
+#include "qopengltimerquery.h"
+#include "qdatetime.h"
+
+CEGUIFrameProfiler::GPUTimer::~GPUTimer()
+{
+    delete _query;
+}
+
+void CEGUIFrameProfiler::GPUTimer::begin(CEGUIFrameProfiler& profiler)
+{
+    if (!profiler.isEnabled() || _unsupported) return;
+
+    if (!_query)
+    {
+        // Requires OpenGL 3.3 or ARB_timer_query
+        _query = new QOpenGLTimerQuery();
+        if (!_query->create())
+        {
+            delete _query;
+            _query = nullptr;
+            _unsupported = true;
+            return;
+        }
+    }
+
+    if (_pending)
+    {
+        if (!_query->isResultAvailable()) return;
+
+        profiler.addGPUTime(_stage, static_cast<qint64>(_query->waitForResult()));
+        _pending = false;
+    }
+
+    _query->begin();
+    _running = true;
+}
+
+void CEGUIFrameProfiler::GPUTimer::end()
+{
+    if (!_running) return;
+
+    _query->end();
+    _running = false;
+    _pending = true;
+}
+
+void CEGUIFrameProfiler::GPUTimer::destroy()
+{
+    delete _query;
+    _query = nullptr;
+    _running = false;
+    _pending = false;
+}
+
+QString CEGUIFrameProfiler::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case Stage::TimePulse: return "CEGUI time pulse";
+        case Stage::CEGUIDraw: return "CEGUI draw";
+        case Stage::Blit: return "FBO blit";
+        case Stage::SceneItems: return "Qt scene items";
+        case Stage::CleanDeadPool: return "Dead pool cleanup";
+    }
+
+    return QString();
+}
+
+void CEGUIFrameProfiler::setEnabled(bool enabled)
+{
+    if (_enabled == enabled) return;
+
+    _enabled = enabled;
+    clear();
+}
+
+void CEGUIFrameProfiler::clear()
+{
+    _current = Frame();
+    _history.clear();
+    _hasGPUTimes = false;
+}
+
+void CEGUIFrameProfiler::addCPUTime(Stage stage, qint64 nsec)
+{
+    if (_enabled) _current.cpu[static_cast<int>(stage)] += nsec;
+}
+
+void CEGUIFrameProfiler::addGPUTime(Stage stage, qint64 nsec)
+{
+    if (!_enabled) return;
+
+    _current.gpu[static_cast<int>(stage)] += nsec;
+    _hasGPUTimes = true;
+}
+
+void CEGUIFrameProfiler::endFrame()
+{
+    if (!_enabled) return;
+
+    _current.endTime = QDateTime::currentMSecsSinceEpoch();
+    _history.push_back(_current);
+    while (_history.size() > HistorySize)
+        _history.pop_front();
+
+    _current = Frame();
+}
@@ -0,0 +1,82 @@
+#ifndef CEGUIFRAMEPROFILER_H
+#define CEGUIFRAMEPROFILER_H
+
+#include "qstring.h"
+#include <deque>
+
+// Per-frame time breakdown of CEGUI view painting, CPU and GPU. A frame is one paint of one view.
+// GPU times come from timer queries which are read back only when ready, so they may be attributed
+// to one of the next frames. Collects nothing until enabled, the debug info dialog enables it.
+
+class QOpenGLTimerQuery;
+
+class CEGUIFrameProfiler
+{
+public:
+
+    enum class Stage
+    {
+        TimePulse,
+        CEGUIDraw,
+        Blit,
+        SceneItems,
+        CleanDeadPool
+    };
+
+    static const int StageCount = 5;
+    static const size_t HistorySize = 120;
+
+    struct Frame
+    {
+        qint64 endTime = 0; // Msecs since epoch
+        qint64 cpu[StageCount] = {};
+        qint64 gpu[StageCount] = {};
+    };
+
+    // Must be used and destroyed with the same OpenGL context current. If the result of the previous
+    // query isn't ready yet, the stage is not measured in this frame instead of stalling the pipeline.
+    class GPUTimer
+    {
+    public:
+
+        explicit GPUTimer(Stage stage) : _stage(stage) {}
+        GPUTimer(const GPUTimer&) = delete;
+        ~GPUTimer();
+
+        GPUTimer& operator =(const GPUTimer&) = delete;
+
+        void begin(CEGUIFrameProfiler& profiler);
+        void end();
+        void destroy();
+
+    protected:
+
+        QOpenGLTimerQuery* _query = nullptr;
+        Stage _stage;
+        bool _running = false;
+        bool _pending = false;
+        bool _unsupported = false;
+    };
+
+    static QString getStageName(Stage stage);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+    void clear();
+
+    void addCPUTime(Stage stage, qint64 nsec);
+    void addGPUTime(Stage stage, qint64 nsec);
+    void endFrame();
+
+    const std::deque<Frame>& getHistory() const { return _history; }
+    bool hasGPUTimes() const { return _hasGPUTimes; }
+
+protected:
+
+    Frame _current;
+    std::deque<Frame> _history; // Oldest first
+    bool _enabled = false;
+    bool _hasGPUTimes = false;
+};
+
+#endif // CEGUIFRAMEPROFILER_H
@@ -9,6 +9,7 @@
 #include "src/cegui/QtnPropertyUBox.h"
 #include "src/ui/CEGUIDebugInfo.h"
 #include "src/util/DismissableMessage.h"
+#include "src/util/Settings.h"
 #include "src/Application.h"
 #include <CEGUI/CEGUI.h>
 #include <CEGUI/RendererModules/OpenGL/GLRenderer.h>
@@ -17,13 +18,14 @@
 #include "QtnProperty/Enum.h"
 #include "QtnProperty/Delegates/PropertyDelegateFactory.h"
 #include "qmessagebox.h"
-#include "qprogressdialog.h"
 #include "qdiriterator.h"
+#include "qcryptographichash.h"
 #include "qopenglcontext.h"
 #include "qoffscreensurface.h"
 #include "qopenglframebufferobject.h"
 #include "qopenglfunctions.h"
 #include <qopenglfunctions_3_2_core.h>
+#include <cmath>
 
 // Allows us to register subscribers that want CEGUI log info
 // This prevents writing CEGUI.log into CWD and allow log display inside the app
@@ -59,6 +61,9 @@ private:
 
 CEGUIManager::CEGUIManager()
 {
+    _resourceTracker.setCache(&_resourceCache);
+    _textureDecoder.setCache(&_resourceCache);
+    _textureDecoder.setTimings(&_syncTimings);
 }
 
 CEGUIManager::~CEGUIManager()
@@ -66,6 +71,10 @@ CEGUIManager::~CEGUIManager()
     if (initialized)
     {
         logger->unsubscribeAll();
+        makeOpenGLContextCurrent();
+        releaseOffscreenTarget(_previewTarget);
+        releaseOffscreenTarget(_thumbnailAtlas);
+        doneOpenGLContextCurrent();
         cleanCEGUIResources();
         if (_isOpenGL3)
             CEGUI::OpenGL3Renderer::destroySystem();
@@ -170,8 +179,12 @@ void CEGUIManager::unloadProject()
 {
     if (!currentProject) return;
 
+    cancelSync();
+
     // Clean resources that were potentially used with this project
     cleanCEGUIResources();
+    _resourceCache.close();
+    _dependencyGraph.clear();
 
     currentProject->unload();
     currentProject.reset();
@@ -277,9 +290,12 @@ void CEGUIManager::ensureCEGUIInitialized()
     initialized = true;
 }
 
+// Cheap when the context is current already, so rendering code can just call it every time
 bool CEGUIManager::makeOpenGLContextCurrent()
 {
-    return glContext ? glContext->makeCurrent(surface) : false;
+    if (!glContext) return false;
+    if (QOpenGLContext::currentContext() == glContext) return true;
+    return glContext->makeCurrent(surface);
 }
 
 void CEGUIManager::doneOpenGLContextCurrent()
@@ -295,9 +311,69 @@ void CEGUIManager::showDebugInfo()
         QMessageBox::warning(nullptr, "CEGUI Debug Info", "CEGUI is not initialized yet. Open a project to launch it.");
 }
 
-// Synchronises the CEGUI instance with the current project, respecting it's paths and resources
-bool CEGUIManager::syncProjectToCEGUIInstance()
+// Absolute paths of resource group directories of the current project, in the order of resource groups
+QStringList CEGUIManager::getProjectResourceDirectories() const
 {
+    if (!currentProject) return {};
+
+    return
+    {
+        currentProject->getAbsolutePathOf(currentProject->imagesetsPath),
+        currentProject->getAbsolutePathOf(currentProject->fontsPath),
+        currentProject->getAbsolutePathOf(currentProject->schemesPath),
+        currentProject->getAbsolutePathOf(currentProject->looknfeelsPath),
+        currentProject->getAbsolutePathOf(currentProject->layoutsPath),
+        currentProject->getAbsolutePathOf(currentProject->xmlSchemasPath)
+    };
+}
+
+// Whether the next incremental synchronisation will keep resources of unchanged files. If not, it falls
+// back to the full rebuild, which destroys all CEGUI windows, so every project dependent tab must be closed.
+bool CEGUIManager::canSyncIncrementally() const
+{
+    if (!currentProject) return false;
+
+    // Tracked state is meaningless if resources are now searched for in other places
+    if (getProjectResourceDirectories() != _resourceTracker.getResourceDirectories())
+        return false;
+
+    // Switching between lazy and eager loading changes what must be loaded for unchanged schemes too
+    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+    return settings->getEntryValue("cegui/resources/lazy_loading").toBool() == _lazyLoading;
+}
+
+// Descriptor files of loaded resources the next incremental synchronisation will rebuild, decided by
+// the same fingerprints the synchronisation uses. A scheme is listed when it is rebuilt as a whole.
+QStringList CEGUIManager::getOutdatedResourceFiles()
+{
+    QStringList outdatedFiles;
+    auto addIfOutdated = [&outdatedFiles](TrackedResource& resource)
+    {
+        if (!resource.files.empty() && !resource.isUpToDate())
+            outdatedFiles.append(QDir::cleanPath(resource.files[0].first));
+    };
+
+    for (auto& scheme : _resourceTracker.getSchemes())
+    {
+        addIfOutdated(scheme.schemeFiles);
+        for (auto& resource : scheme.imagesets) addIfOutdated(resource);
+        for (auto& resource : scheme.fonts) addIfOutdated(resource);
+        for (auto& resource : scheme.looknfeels) addIfOutdated(resource);
+    }
+
+    return outdatedFiles;
+}
+
+// Synchronises the CEGUI instance with the current project, respecting it's paths and resources.
+// Only plans the work and returns, resources are loaded by a CEGUIProjectSyncJob in small steps
+// while the UI stays responsive. When 'incremental' is set, only schemes and resources whose files
+// have changed since the last synchronisation are rebuilt. Falls back to the full rebuild if there
+// is nothing to compare with. Returns false if the synchronisation couldn't be started.
+bool CEGUIManager::syncProjectToCEGUIInstance(bool incremental)
+{
+    // A new synchronisation supersedes the running one
+    cancelSync();
+
     if (!currentProject)
     {
         cleanCEGUIResources();
@@ -314,20 +390,19 @@ bool CEGUIManager::syncProjectToCEGUIInstance()
         return false;
     }
 
-    QProgressDialog progress(mainWnd);
-    progress.setWindowModality(Qt::WindowModal);
-    progress.setWindowTitle("Synchronising embedded CEGUI with the project");
-    progress.setCancelButton(nullptr);
-    progress.resize(400, 100);
-    progress.show();
-
     ensureCEGUIInitialized();
 
+    // Hashes, descriptors and decoded textures of unchanged files are reused from the previous runs
+    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+    if (settings->getEntryValue("cegui/resources/disk_cache").toBool())
+        _resourceCache.open(currentProject->filePath);
+    else
+        _resourceCache.detach();
+
     QStringList schemeFiles;
     auto absoluteSchemesPath = currentProject->getAbsolutePathOf(currentProject->schemesPath);
     if (!QDir(absoluteSchemesPath).exists())
     {
-        progress.reset();
         QMessageBox::warning(mainWnd, "Failed to synchronise embedded CEGUI to your project",
            "Can't list scheme path '" + absoluteSchemesPath + "'\n\n"
            "This means that editing capabilities of CEED will be limited to editing of files "
@@ -344,234 +419,737 @@ bool CEGUIManager::syncProjectToCEGUIInstance()
             schemeFiles.append(schemesIt.fileName());
     }
 
-    progress.setMinimum(0);
-    progress.setMaximum(2 + 9 * schemeFiles.size());
+    const QStringList resourceDirs = getProjectResourceDirectories();
 
-    progress.setLabelText("Purging all resources...");
-    progress.setValue(0);
-    QApplication::instance()->processEvents();
+    if (!canSyncIncrementally())
+        incremental = false;
+    _lazyLoading = settings->getEntryValue("cegui/resources/lazy_loading").toBool();
 
     // Destroy all previous resources (if any)
-    cleanCEGUIResources();
-
-    progress.setLabelText("Setting resource paths...");
-    progress.setValue(1);
-    QApplication::instance()->processEvents();
+    if (!incremental)
+        cleanCEGUIResources();
 
     auto resProvider = dynamic_cast<CEGUI::DefaultResourceProvider*>(CEGUI::System::getSingleton().getResourceProvider());
     if (resProvider)
     {
-        resProvider->setResourceGroupDirectory("imagesets", CEGUIUtils::qStringToString(currentProject->getAbsolutePathOf(currentProject->imagesetsPath)));
-        resProvider->setResourceGroupDirectory("fonts", CEGUIUtils::qStringToString(currentProject->getAbsolutePathOf(currentProject->fontsPath)));
-        resProvider->setResourceGroupDirectory("schemes", CEGUIUtils::qStringToString(currentProject->getAbsolutePathOf(currentProject->schemesPath)));
-        resProvider->setResourceGroupDirectory("looknfeels", CEGUIUtils::qStringToString(currentProject->getAbsolutePathOf(currentProject->looknfeelsPath)));
-        resProvider->setResourceGroupDirectory("layouts", CEGUIUtils::qStringToString(currentProject->getAbsolutePathOf(currentProject->layoutsPath)));
-        resProvider->setResourceGroupDirectory("xml_schemas", CEGUIUtils::qStringToString(currentProject->getAbsolutePathOf(currentProject->xmlSchemasPath)));
+        resProvider->setResourceGroupDirectory("imagesets", CEGUIUtils::qStringToString(resourceDirs[0]));
+        resProvider->setResourceGroupDirectory("fonts", CEGUIUtils::qStringToString(resourceDirs[1]));
+        resProvider->setResourceGroupDirectory("schemes", CEGUIUtils::qStringToString(resourceDirs[2]));
+        resProvider->setResourceGroupDirectory("looknfeels", CEGUIUtils::qStringToString(resourceDirs[3]));
+        resProvider->setResourceGroupDirectory("layouts", CEGUIUtils::qStringToString(resourceDirs[4]));
+        resProvider->setResourceGroupDirectory("xml_schemas", CEGUIUtils::qStringToString(resourceDirs[5]));
     }
 
-    progress.setLabelText("Recreating all schemes...");
-    progress.setValue(2);
-    QApplication::instance()->processEvents();
+    _resourceTracker.setResourceDirectories(resourceDirs);
 
-    makeOpenGLContextCurrent();
+    const QStringList resourceGroups = { "imagesets", "fonts", "schemes", "looknfeels", "layouts", "xml_schemas" };
+    _textureDecoder.setPathResolver([resourceGroups, resourceDirs](const QString& fileName, const QString& resourceGroup)
+    {
+        const int index = resourceGroups.indexOf(resourceGroup);
+        return (index < 0) ? QString() : QDir::cleanPath(QDir(resourceDirs[index]).filePath(fileName));
+    });
+
+    _syncTimings.clear();
+    _syncTimer.start();
+
+    _syncJob = new CEGUIProjectSyncJob([this](CEGUIProjectSyncJob::Result result, const QString& error)
+    {
+        onSyncFinished(result, error);
+    });
+
+    if (incremental)
+    {
+        // Schemes deleted from the project since the last synchronisation
+        for (const auto& trackedScheme : _resourceTracker.getSchemes())
+        {
+            if (schemeFiles.contains(trackedScheme.fileName)) continue;
+
+            const QString schemeFile = trackedScheme.fileName;
+            _syncJob->addStep(QString("Destroying the removed scheme (%1)").arg(schemeFile), [this, schemeFile]()
+            {
+                if (auto removedScheme = _resourceTracker.findScheme(schemeFile))
+                {
+                    unloadScheme(*removedScheme);
+                    _resourceTracker.removeScheme(schemeFile);
+                }
+            });
+        }
+    }
+
+    // Names of resources available for loading on demand are collected anew, any file could change them
+    _resourceTracker.clearDeferredResources();
+    _lazyDefaultFont.clear();
+
+    for (const auto& schemeFile : schemeFiles)
+    {
+        if (_lazyLoading) deferSchemeResources(schemeFile);
+
+        auto trackedScheme = incremental ? _resourceTracker.findScheme(schemeFile) : nullptr;
+        if (trackedScheme && trackedScheme->schemeFiles.isUpToDate())
+            planChangedResourcesReload(*trackedScheme);
+        else
+            planSchemeLoading(schemeFile);
+    }
 
     // We will load resources manually to be able to use the compatibility layer machinery
     CEGUI::SchemeManager::getSingleton().setAutoLoadResources(false);
 
-    bool result = true;
-    try
+    _syncJob->start();
+
+    return true;
+}
+
+// Stops the running synchronisation, leaving only fully loaded schemes in CEGUI
+void CEGUIManager::cancelSync()
+{
+    if (_syncJob) _syncJob->cancel();
+}
+
+void CEGUIManager::onSyncFinished(CEGUIProjectSyncJob::Result result, const QString& error)
+{
+    makeOpenGLContextCurrent();
+
+    if (result == CEGUIProjectSyncJob::Result::Cancelled)
+    {
+        // Partially loaded scheme is rolled back, the next incremental sync will load it anew
+        if (_pendingScheme) unloadScheme(*_pendingScheme);
+    }
+    else if (result == CEGUIProjectSyncJob::Result::Failed)
+    {
+        cleanCEGUIResources();
+    }
+
+    _pendingScheme.reset();
+    _pendingCEGUIScheme = nullptr;
+    _textureDecoder.clear();
+    _resourceCache.save();
+
+    // Put SchemeManager into the default state again
+    CEGUI::SchemeManager::getSingleton().setAutoLoadResources(true);
+
+    doneOpenGLContextCurrent();
+
+    _syncJob->deleteLater();
+    _syncJob = nullptr;
+
+    ++_resourceGeneration;
+    ++_resourceLoadGeneration;
+
+    _syncTimings.setTotalTime(_syncTimer.nsecsElapsed());
+    if (debugInfo) debugInfo->updateSyncTimings();
+
+    // Remember the state of files resources were loaded from, targeted reloads start from it
+    if (result == CEGUIProjectSyncJob::Result::Succeeded)
+        _dependencyGraph.scan(*currentProject);
+
+    if (result == CEGUIProjectSyncJob::Result::Failed)
+    {
+        QMessageBox::warning(qobject_cast<Application*>(qApp)->getMainWindow(), "Failed to synchronise embedded CEGUI to your project",
+            QString("An attempt was made to load resources related to the project being opened, "
+            "for some reason the loading didn't succeed so all resources were destroyed! "
+            "The most likely reason is that the resource directories are wrong, this can "
+            "be very easily remedied in the project settings.\n\n"
+            "This means that editing capabilities of CEED will be limited to editing of files "
+            "that don't require a project opened (for example: imagesets).\nException: %1").arg(error));
+    }
+}
+
+// Starts decoding of textures of the scheme's XML imagesets in worker threads. In lazy mode they
+// are decoded only when something needs them. Image file imagesets are left to CEGUI, it creates
+// their textures itself and refuses to reuse an existing one, unlike the XML imageset loader.
+void CEGUIManager::enqueueSchemeTextures(const QString& schemeFile)
+{
+    if (_lazyLoading) return;
+
+    const QString schemeFilePath = currentProject->getResourceFilePath(schemeFile, "schemes");
+
+    for (const auto& attrs : _resourceCache.readElementAttributes(schemeFilePath, "Imageset"))
+    {
+        QString resourceGroup = attrs.value("resourceGroup").toString();
+        if (resourceGroup.isEmpty()) resourceGroup = "imagesets";
+        _textureDecoder.enqueueImageset(currentProject->getResourceFilePath(attrs.value("filename").toString(), resourceGroup));
+    }
+}
+
+// Adds steps loading a scheme and all its resources one by one. The resource list is read from
+// the scheme file in advance, so that the progress can be reported per resource. In lazy mode
+// only the scheme itself, its image file imagesets and window factories are loaded.
+void CEGUIManager::planSchemeLoading(const QString& schemeFile)
+{
+    // Textures are decoded in worker threads while the main thread loads everything else
+    enqueueSchemeTextures(schemeFile);
+
+    const QString schemeFilePath = currentProject->getResourceFilePath(schemeFile, "schemes");
+
+    _syncJob->addStep(QString("Parsing the scheme file (%1)").arg(schemeFile), [this, schemeFile]()
+    {
+        beginSchemeLoading(schemeFile);
+    });
+
+    // In lazy mode these are loaded on demand, see loadDeferredReferences
+    auto getResourceElements = [this, &schemeFilePath](const QString& elementName)
+    {
+        return _lazyLoading ? std::vector<QXmlStreamAttributes>() : _resourceCache.readElementAttributes(schemeFilePath, elementName);
+    };
+
+    // NOTE: This is very CEGUI implementation specific unfortunately!
+    //       However I am not really sure how to do this any better.
+    for (const auto& attrs : getResourceElements("Imageset"))
+    {
+        const QString fileName = attrs.value("filename").toString();
+        const QString resourceGroup = attrs.value("resourceGroup").toString();
+        _syncJob->addStep(QString("Loading XML imageset '%1' (%2)").arg(fileName, schemeFile), [this, fileName, resourceGroup]()
+        {
+            loadSchemeImageset(*_pendingScheme, fileName, resourceGroup);
+        });
+    }
+
+    _syncJob->addStep(QString("Loading image file imagesets (%1)").arg(schemeFile), [this, schemeFile]()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        _pendingCEGUIScheme->loadImageFileImagesets();
+
+        _syncTimings.addRecord(CEGUISyncTimings::Stage::ImagesetParse, schemeFile, "<image file imagesets>", timer.nsecsElapsed());
+    });
+
+    for (const auto& attrs : getResourceElements("Font"))
     {
-        auto updateProgress = [&progress](const QString& schemeFile, const QString& message)
+        const QString fileName = attrs.value("filename").toString();
+        const QString resourceGroup = attrs.value("resourceGroup").toString();
+        _syncJob->addStep(QString("Loading font '%1' (%2)").arg(fileName, schemeFile), [this, fileName, resourceGroup]()
         {
-            progress.setValue(progress.value() + 1);
-            progress.setLabelText(QString("Recreating all schemes... (%1)\n\n%2").arg(schemeFile, message));
-            QApplication::instance()->processEvents();
-        };
+            loadSchemeFont(*_pendingScheme, fileName, resourceGroup);
+        });
+    }
 
-        for (auto& schemeFile : schemeFiles)
+    for (const auto& attrs : getResourceElements("LookNFeel"))
+    {
+        const QString fileName = attrs.value("filename").toString();
+        const QString resourceGroup = attrs.value("resourceGroup").toString();
+        _syncJob->addStep(QString("Loading looknfeel '%1' (%2)").arg(fileName, schemeFile), [this, fileName, resourceGroup]()
         {
-            updateProgress(schemeFile, "Parsing the scheme file");
+            loadSchemeLookNFeel(*_pendingScheme, fileName, resourceGroup);
+        });
+    }
 
-            /*
-            auto schemeResourceGroup = CEGUIUtils::stringToQString(CEGUI::Scheme::getDefaultResourceGroup());
-            auto schemeFilePath = currentProject->getResourceFilePath(schemeFile, schemeResourceGroup.c_str());
+    _syncJob->addStep(QString("Loading window factories and mappings (%1)").arg(schemeFile), [this]()
+    {
+        endSchemeLoading();
+    });
+}
 
-            rawData = open(schemeFile, "r").read()
-            rawDataType = scheme_compatibility.manager.EditorNativeType
+// Adds steps reloading imagesets, fonts and looknfeels of the scheme which were changed on disk. Window
+// factories and mappings are defined in the scheme file itself, so they can't change without it changing.
+void CEGUIManager::planChangedResourcesReload(TrackedScheme& trackedScheme)
+{
+    const QString schemeFile = trackedScheme.fileName;
 
-            try:
-                rawDataType = scheme_compatibility.manager.guessType(rawData, schemeFile)
+    for (size_t i = 0; i < trackedScheme.imagesets.size(); ++i)
+    {
+        auto& imageset = trackedScheme.imagesets[i];
+        if (imageset.isUpToDate()) continue;
 
-            except compatibility.NoPossibleTypesError:
-                QtGui.QMessageBox.warning(None, "Scheme doesn't match any known data type", "The scheme '%s' wasn't recognised by CEED as any scheme data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (schemeFile))
-                return
+        _textureDecoder.enqueueImageset(imageset.files[0].first);
 
-            except compatibility.MultiplePossibleTypesError as e:
-                suitableVersion = scheme_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
+        _syncJob->addStep(QString("Reloading imageset '%1' (%2)").arg(imageset.fileName, schemeFile), [this, schemeFile, i]()
+        {
+            if (auto scheme = _resourceTracker.findScheme(schemeFile))
+                reloadImageset(schemeFile, scheme->imagesets[i]);
+        });
+    }
 
-                if suitableVersion not in e.possibleTypes:
-                    QtGui.QMessageBox.warning(None, "Incorrect scheme data type", "The scheme '%s' checked out as some potential data types, however not any of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (schemeFile, suitableVersion))
-                    return
+    for (size_t i = 0; i < trackedScheme.fonts.size(); ++i)
+    {
+        auto& font = trackedScheme.fonts[i];
+        if (font.isUpToDate()) continue;
 
-                rawDataType = suitableVersion
+        _syncJob->addStep(QString("Reloading font '%1' (%2)").arg(font.fileName, schemeFile), [this, schemeFile, i]()
+        {
+            if (auto scheme = _resourceTracker.findScheme(schemeFile))
+                reloadFont(schemeFile, scheme->fonts[i]);
+        });
+    }
 
-            nativeData = scheme_compatibility.manager.transform(rawDataType, scheme_compatibility.manager.EditorNativeType, rawData)
-            scheme = CEGUI::SchemeManager::getSingleton().createFromString(nativeData)
-            */
+    for (size_t i = 0; i < trackedScheme.looknfeels.size(); ++i)
+    {
+        auto& looknfeel = trackedScheme.looknfeels[i];
+        if (looknfeel.isUpToDate()) continue;
 
-            CEGUI::Scheme& scheme = CEGUI::SchemeManager::getSingleton().createFromFile(CEGUIUtils::qStringToString(schemeFile));
+        _syncJob->addStep(QString("Reloading looknfeel '%1' (%2)").arg(looknfeel.fileName, schemeFile), [this, schemeFile, i]()
+        {
+            if (auto scheme = _resourceTracker.findScheme(schemeFile))
+                reloadLookNFeel(schemeFile, scheme->looknfeels[i]);
+        });
+    }
+}
 
-            // NOTE: This is very CEGUI implementation specific unfortunately!
-            //       However I am not really sure how to do this any better.
-            updateProgress(schemeFile, "Loading XML imagesets");
+// Remembers which files define imagesets, fonts and widget looks of the scheme, so that they can be
+// loaded by name when first needed. Descriptors are read through the cache and cost almost nothing.
+void CEGUIManager::deferSchemeResources(const QString& schemeFile)
+{
+    const QString schemeFilePath = currentProject->getResourceFilePath(schemeFile, "schemes");
 
-            auto xmlImagesetIterator = scheme.getXMLImagesets();
-            while (!xmlImagesetIterator.isAtEnd())
+    auto deferFile = [this, &schemeFile, &schemeFilePath](CEGUIResourceTracker::ResourceType type, const QString& schemeElement,
+                                                          const QString& defaultGroup, const QString& objectElement)
+    {
+        for (const auto& attrs : _resourceCache.readElementAttributes(schemeFilePath, schemeElement))
+        {
+            DeferredResource resource;
+            resource.schemeFile = schemeFile;
+            resource.fileName = attrs.value("filename").toString();
+            resource.resourceGroup = attrs.value("resourceGroup").toString();
+
+            const QString group = resource.resourceGroup.isEmpty() ? defaultGroup : resource.resourceGroup;
+            const QString filePath = currentProject->getResourceFilePath(resource.fileName, group);
+            for (const auto& objectAttrs : _resourceCache.readElementAttributes(filePath, objectElement))
             {
-                auto loadableUIElement = xmlImagesetIterator.getCurrentValue();
+                const QString objectName = objectAttrs.value("name").toString();
+                _resourceTracker.deferResource(type, objectName, resource);
 
-                /*
-                imagesetFilePath = project.getResourceFilePath(loadableUIElement.filename, loadableUIElement.resourceGroup if loadableUIElement.resourceGroup != "" else CEGUI::ImageManager.getImagesetDefaultResourceGroup())
-                imagesetRawData = open(imagesetFilePath, "r").read()
-                imagesetRawDataType = imageset_compatibility.manager.EditorNativeType
+                if (type == CEGUIResourceTracker::ResourceType::Font && _lazyDefaultFont.isEmpty())
+                    _lazyDefaultFont = objectName;
+            }
+        }
+    };
 
-                try:
-                    imagesetRawDataType = imageset_compatibility.manager.guessType(imagesetRawData, imagesetFilePath)
+    deferFile(CEGUIResourceTracker::ResourceType::Imageset, "Imageset", "imagesets", "Imageset");
+    deferFile(CEGUIResourceTracker::ResourceType::Font, "Font", "fonts", "Font");
+    deferFile(CEGUIResourceTracker::ResourceType::LookNFeel, "LookNFeel", "looknfeels", "WidgetLook");
+}
 
-                except compatibility.NoPossibleTypesError:
-                    QtGui.QMessageBox.warning(None, "Imageset doesn't match any known data type", "The imageset '%s' wasn't recognised by CEED as any imageset data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (imagesetFilePath))
-                    return
+// Creates a scheme object. Its resources are loaded by subsequent steps, and until the last
+// of them is done the scheme is considered pending and will be rolled back on cancellation.
+void CEGUIManager::beginSchemeLoading(const QString& schemeFile)
+{
+    if (auto outdatedScheme = _resourceTracker.findScheme(schemeFile))
+    {
+        unloadScheme(*outdatedScheme);
+        _resourceTracker.removeScheme(schemeFile);
+    }
 
-                except compatibility.MultiplePossibleTypesError as e:
-                    suitableVersion = imageset_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
+    /*
+    auto schemeResourceGroup = CEGUIUtils::stringToQString(CEGUI::Scheme::getDefaultResourceGroup());
+    auto schemeFilePath = currentProject->getResourceFilePath(schemeFile, schemeResourceGroup.c_str());
 
-                    if suitableVersion not in e.possibleTypes:
-                        QtGui.QMessageBox.warning(None, "Incorrect imageset data type", "The imageset '%s' checked out as some potential data types, however none of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (imagesetFilePath, suitableVersion))
-                        return
+    rawData = open(schemeFile, "r").read()
+    rawDataType = scheme_compatibility.manager.EditorNativeType
 
-                    imagesetRawDataType = suitableVersion
+    try:
+        rawDataType = scheme_compatibility.manager.guessType(rawData, schemeFile)
 
-                imagesetNativeData = imageset_compatibility.manager.transform(imagesetRawDataType, imageset_compatibility.manager.EditorNativeType, imagesetRawData)
+    except compatibility.NoPossibleTypesError:
+        QtGui.QMessageBox.warning(None, "Scheme doesn't match any known data type", "The scheme '%s' wasn't recognised by CEED as any scheme data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (schemeFile))
+        return
 
-                CEGUI::ImageManager::getSingleton().loadImagesetFromString(imagesetNativeData)
-                */
+    except compatibility.MultiplePossibleTypesError as e:
+        suitableVersion = scheme_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
 
-                CEGUI::ImageManager::getSingleton().loadImageset(loadableUIElement.filename, loadableUIElement.resourceGroup);
+        if suitableVersion not in e.possibleTypes:
+            QtGui.QMessageBox.warning(None, "Incorrect scheme data type", "The scheme '%s' checked out as some potential data types, however not any of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (schemeFile, suitableVersion))
+            return
 
-                ++xmlImagesetIterator;
-            }
+        rawDataType = suitableVersion
 
-            updateProgress(schemeFile, "Loading image file imagesets");
+    nativeData = scheme_compatibility.manager.transform(rawDataType, scheme_compatibility.manager.EditorNativeType, rawData)
+    scheme = CEGUI::SchemeManager::getSingleton().createFromString(nativeData)
+    */
 
-            scheme.loadImageFileImagesets();
+    QElapsedTimer timer;
+    timer.start();
 
-            updateProgress(schemeFile, "Loading fonts");
+    CEGUI::Scheme& scheme = CEGUI::SchemeManager::getSingleton().createFromFile(CEGUIUtils::qStringToString(schemeFile));
 
-            auto fontIterator = scheme.getFonts();
-            while (!fontIterator.isAtEnd())
-            {
-                auto loadableUIElement = fontIterator.getCurrentValue();
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::SchemeParse, schemeFile, schemeFile, timer.nsecsElapsed());
 
-                /*
-                fontFilePath = project.getResourceFilePath(loadableUIElement.filename, loadableUIElement.resourceGroup if loadableUIElement.resourceGroup != "" else CEGUI::Font.getDefaultResourceGroup())
-                fontRawData = open(fontFilePath, "r").read()
-                fontRawDataType = font_compatibility.manager.EditorNativeType
+    _pendingCEGUIScheme = &scheme;
+    _pendingScheme.reset(new TrackedScheme());
+    _pendingScheme->name = CEGUIUtils::stringToQString(scheme.getName());
+    _pendingScheme->fileName = schemeFile;
+    _pendingScheme->schemeFiles = _resourceTracker.trackResource(*currentProject, CEGUIResourceTracker::ResourceType::Scheme,
+                                                                 schemeFile, CEGUIUtils::stringToQString(CEGUI::Scheme::getDefaultResourceGroup()));
+}
 
-                try:
-                    fontRawDataType = font_compatibility.manager.guessType(fontRawData, fontFilePath)
+void CEGUIManager::loadSchemeImageset(TrackedScheme& scheme, const QString& fileName, const QString& resourceGroup)
+{
+    const QString group = resourceGroup.isEmpty() ?
+                CEGUIUtils::stringToQString(CEGUI::ImageManager::getImagesetDefaultResourceGroup()) : resourceGroup;
 
-                except compatibility.NoPossibleTypesError:
-                    QtGui.QMessageBox.warning(None, "Font doesn't match any known data type", "The font '%s' wasn't recognised by CEED as any font data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (fontFilePath))
-                    return
+    /*
+    imagesetFilePath = project.getResourceFilePath(loadableUIElement.filename, loadableUIElement.resourceGroup if loadableUIElement.resourceGroup != "" else CEGUI::ImageManager.getImagesetDefaultResourceGroup())
+    imagesetRawData = open(imagesetFilePath, "r").read()
+    imagesetRawDataType = imageset_compatibility.manager.EditorNativeType
 
-                except compatibility.MultiplePossibleTypesError as e:
-                    suitableVersion = font_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
+    try:
+        imagesetRawDataType = imageset_compatibility.manager.guessType(imagesetRawData, imagesetFilePath)
 
-                    if suitableVersion not in e.possibleTypes:
-                        QtGui.QMessageBox.warning(None, "Incorrect font data type", "The font '%s' checked out as some potential data types, however none of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (fontFilePath, suitableVersion))
-                        return
+    except compatibility.NoPossibleTypesError:
+        QtGui.QMessageBox.warning(None, "Imageset doesn't match any known data type", "The imageset '%s' wasn't recognised by CEED as any imageset data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (imagesetFilePath))
+        return
 
-                    fontRawDataType = suitableVersion
+    except compatibility.MultiplePossibleTypesError as e:
+        suitableVersion = imageset_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
 
-                fontNativeData = font_compatibility.manager.transform(fontRawDataType, font_compatibility.manager.EditorNativeType, fontRawData)
+        if suitableVersion not in e.possibleTypes:
+            QtGui.QMessageBox.warning(None, "Incorrect imageset data type", "The imageset '%s' checked out as some potential data types, however none of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (imagesetFilePath, suitableVersion))
+            return
 
-                CEGUI::FontManager::getSingleton().createFromString(fontNativeData)
-                */
+        imagesetRawDataType = suitableVersion
 
-                CEGUI::FontManager::getSingleton().createFromFile(loadableUIElement.filename, loadableUIElement.resourceGroup);
+    imagesetNativeData = imageset_compatibility.manager.transform(imagesetRawDataType, imageset_compatibility.manager.EditorNativeType, imagesetRawData)
 
-                ++fontIterator;
-            }
+    CEGUI::ImageManager::getSingleton().loadImagesetFromString(imagesetNativeData)
+    */
 
-            updateProgress(schemeFile, "Loading looknfeels");
+    // Upload pixels decoded in advance, CEGUI will pick the texture by the imageset name
+    _textureDecoder.createTexture(currentProject->getResourceFilePath(fileName, group), scheme.fileName);
 
-            auto looknfeelIterator = scheme.getLookNFeels();
-            while (!looknfeelIterator.isAtEnd())
-            {
-                auto loadableUIElement = looknfeelIterator.getCurrentValue();
+    QElapsedTimer timer;
+    timer.start();
+
+    CEGUI::ImageManager::getSingleton().loadImageset(CEGUIUtils::qStringToString(fileName), CEGUIUtils::qStringToString(resourceGroup));
 
-                /*
-                looknfeelFilePath = project.getResourceFilePath(loadableUIElement.filename, loadableUIElement.resourceGroup if loadableUIElement.resourceGroup != "" else CEGUI::WidgetLookManager.getDefaultResourceGroup())
-                looknfeelRawData = open(looknfeelFilePath, "r").read()
-                looknfeelRawDataType = looknfeel_compatibility.manager.EditorNativeType
-                try:
-                    looknfeelRawDataType = looknfeel_compatibility.manager.guessType(looknfeelRawData, looknfeelFilePath)
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::ImagesetParse, scheme.fileName, fileName, timer.nsecsElapsed());
 
-                except compatibility.NoPossibleTypesError:
-                    QtGui.QMessageBox.warning(None, "LookNFeel doesn't match any known data type", "The looknfeel '%s' wasn't recognised by CEED as any looknfeel data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (looknfeelFilePath))
-                    return
+    scheme.imagesets.push_back(_resourceTracker.trackResource(*currentProject, CEGUIResourceTracker::ResourceType::Imageset,
+                                                              fileName, group));
+}
+
+void CEGUIManager::loadSchemeFont(TrackedScheme& scheme, const QString& fileName, const QString& resourceGroup)
+{
+    const QString group = resourceGroup.isEmpty() ?
+                CEGUIUtils::stringToQString(CEGUI::Font::getDefaultResourceGroup()) : resourceGroup;
 
-                except compatibility.MultiplePossibleTypesError as e:
-                    suitableVersion = looknfeel_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
+    /*
+    fontFilePath = project.getResourceFilePath(loadableUIElement.filename, loadableUIElement.resourceGroup if loadableUIElement.resourceGroup != "" else CEGUI::Font.getDefaultResourceGroup())
+    fontRawData = open(fontFilePath, "r").read()
+    fontRawDataType = font_compatibility.manager.EditorNativeType
 
-                    if suitableVersion not in e.possibleTypes:
-                        QtGui.QMessageBox.warning(None, "Incorrect looknfeel data type", "The looknfeel '%s' checked out as some potential data types, however none of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (looknfeelFilePath, suitableVersion))
-                        return
+    try:
+        fontRawDataType = font_compatibility.manager.guessType(fontRawData, fontFilePath)
 
-                    looknfeelRawDataType = suitableVersion
+    except compatibility.NoPossibleTypesError:
+        QtGui.QMessageBox.warning(None, "Font doesn't match any known data type", "The font '%s' wasn't recognised by CEED as any font data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (fontFilePath))
+        return
 
-                looknfeelNativeData = looknfeel_compatibility.manager.transform(looknfeelRawDataType, looknfeel_compatibility.manager.EditorNativeType, looknfeelRawData)
+    except compatibility.MultiplePossibleTypesError as e:
+        suitableVersion = font_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
 
-                CEGUI::WidgetLookManager::getSingleton().parseLookNFeelSpecificationFromString(looknfeelNativeData)
-                */
+        if suitableVersion not in e.possibleTypes:
+            QtGui.QMessageBox.warning(None, "Incorrect font data type", "The font '%s' checked out as some potential data types, however none of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (fontFilePath, suitableVersion))
+            return
 
-                CEGUI::WidgetLookManager::getSingleton().parseLookNFeelSpecificationFromFile(loadableUIElement.filename, loadableUIElement.resourceGroup);
+        fontRawDataType = suitableVersion
 
-                ++looknfeelIterator;
-            }
+    fontNativeData = font_compatibility.manager.transform(fontRawDataType, font_compatibility.manager.EditorNativeType, fontRawData)
+
+    CEGUI::FontManager::getSingleton().createFromString(fontNativeData)
+    */
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CEGUI::FontManager::getSingleton().createFromFile(CEGUIUtils::qStringToString(fileName), CEGUIUtils::qStringToString(resourceGroup));
+
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::FontLoad, scheme.fileName, fileName, timer.nsecsElapsed());
+
+    scheme.fonts.push_back(_resourceTracker.trackResource(*currentProject, CEGUIResourceTracker::ResourceType::Font,
+                                                          fileName, group));
+}
+
+void CEGUIManager::loadSchemeLookNFeel(TrackedScheme& scheme, const QString& fileName, const QString& resourceGroup)
+{
+    const QString group = resourceGroup.isEmpty() ?
+                CEGUIUtils::stringToQString(CEGUI::WidgetLookManager::getDefaultResourceGroup()) : resourceGroup;
+
+    /*
+    looknfeelFilePath = project.getResourceFilePath(loadableUIElement.filename, loadableUIElement.resourceGroup if loadableUIElement.resourceGroup != "" else CEGUI::WidgetLookManager.getDefaultResourceGroup())
+    looknfeelRawData = open(looknfeelFilePath, "r").read()
+    looknfeelRawDataType = looknfeel_compatibility.manager.EditorNativeType
+    try:
+        looknfeelRawDataType = looknfeel_compatibility.manager.guessType(looknfeelRawData, looknfeelFilePath)
+
+    except compatibility.NoPossibleTypesError:
+        QtGui.QMessageBox.warning(None, "LookNFeel doesn't match any known data type", "The looknfeel '%s' wasn't recognised by CEED as any looknfeel data type known to it. Please check that the data isn't corrupted. CEGUI instance synchronisation aborted!" % (looknfeelFilePath))
+        return
+
+    except compatibility.MultiplePossibleTypesError as e:
+        suitableVersion = looknfeel_compatibility.manager.getSuitableDataTypeForCEGUIVersion(project.CEGUIVersion)
+
+        if suitableVersion not in e.possibleTypes:
+            QtGui.QMessageBox.warning(None, "Incorrect looknfeel data type", "The looknfeel '%s' checked out as some potential data types, however none of these is suitable for your project's target CEGUI version '%s', please check your project settings! CEGUI instance synchronisation aborted!" % (looknfeelFilePath, suitableVersion))
+            return
+
+        looknfeelRawDataType = suitableVersion
+
+    looknfeelNativeData = looknfeel_compatibility.manager.transform(looknfeelRawDataType, looknfeel_compatibility.manager.EditorNativeType, looknfeelRawData)
+
+    CEGUI::WidgetLookManager::getSingleton().parseLookNFeelSpecificationFromString(looknfeelNativeData)
+    */
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CEGUI::WidgetLookManager::getSingleton().parseLookNFeelSpecificationFromFile(CEGUIUtils::qStringToString(fileName), CEGUIUtils::qStringToString(resourceGroup));
+
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::LookNFeelParse, scheme.fileName, fileName, timer.nsecsElapsed());
+
+    scheme.looknfeels.push_back(_resourceTracker.trackResource(*currentProject, CEGUIResourceTracker::ResourceType::LookNFeel,
+                                                               fileName, group));
+}
+
+void CEGUIManager::endSchemeLoading()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    _pendingCEGUIScheme->loadWindowRendererFactories();
+    _pendingCEGUIScheme->loadWindowFactories();
+    _pendingCEGUIScheme->loadFactoryAliases();
+    _pendingCEGUIScheme->loadFalagardMappings();
+
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::Factories, _pendingScheme->fileName, _pendingScheme->fileName, timer.nsecsElapsed());
+
+    _resourceTracker.getSchemes().push_back(std::move(*_pendingScheme));
+    _pendingScheme.reset();
+    _pendingCEGUIScheme = nullptr;
+}
+
+// Destroys a scheme along with all resources we loaded for it manually
+void CEGUIManager::unloadScheme(const TrackedScheme& trackedScheme)
+{
+    for (const auto& imageset : trackedScheme.imagesets)
+        for (const auto& name : imageset.objectNames)
+            CEGUI::ImageManager::getSingleton().destroyImageCollection(CEGUIUtils::qStringToString(name));
+
+    for (const auto& font : trackedScheme.fonts)
+        for (const auto& name : font.objectNames)
+            CEGUI::FontManager::getSingleton().destroy(CEGUIUtils::qStringToString(name));
+
+    for (const auto& looknfeel : trackedScheme.looknfeels)
+        for (const auto& name : looknfeel.objectNames)
+            CEGUI::WidgetLookManager::getSingleton().eraseWidgetLook(CEGUIUtils::qStringToString(name));
+
+    // Scheme destruction unloads factories, aliases, mappings and image file imagesets it registered
+    CEGUI::SchemeManager::getSingleton().destroy(CEGUIUtils::qStringToString(trackedScheme.name));
+}
+
+void CEGUIManager::reloadImageset(const QString& schemeFile, TrackedResource& imageset)
+{
+    for (const auto& name : imageset.objectNames)
+        CEGUI::ImageManager::getSingleton().destroyImageCollection(CEGUIUtils::qStringToString(name));
+
+    _textureDecoder.createTexture(imageset.files[0].first, schemeFile);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CEGUI::ImageManager::getSingleton().loadImageset(CEGUIUtils::qStringToString(imageset.fileName),
+                                                     CEGUIUtils::qStringToString(imageset.resourceGroup));
+
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::ImagesetParse, schemeFile, imageset.fileName, timer.nsecsElapsed());
+
+    imageset = _resourceTracker.trackResource(*currentProject, CEGUIResourceTracker::ResourceType::Imageset,
+                                              imageset.fileName, imageset.resourceGroup);
+}
+
+void CEGUIManager::reloadFont(const QString& schemeFile, TrackedResource& font)
+{
+    for (const auto& name : font.objectNames)
+        CEGUI::FontManager::getSingleton().destroy(CEGUIUtils::qStringToString(name));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CEGUI::FontManager::getSingleton().createFromFile(CEGUIUtils::qStringToString(font.fileName),
+                                                      CEGUIUtils::qStringToString(font.resourceGroup));
+
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::FontLoad, schemeFile, font.fileName, timer.nsecsElapsed());
+
+    font = _resourceTracker.trackResource(*currentProject, CEGUIResourceTracker::ResourceType::Font,
+                                          font.fileName, font.resourceGroup);
+}
 
-            updateProgress(schemeFile, "Loading window renderer factory modules");
-            scheme.loadWindowRendererFactories();
-            updateProgress(schemeFile, "Loading window factories");
-            scheme.loadWindowFactories();
-            updateProgress(schemeFile, "Loading factory aliases");
-            scheme.loadFactoryAliases();
-            updateProgress(schemeFile, "Loading falagard mappings");
-            scheme.loadFalagardMappings();
+void CEGUIManager::reloadLookNFeel(const QString& schemeFile, TrackedResource& looknfeel)
+{
+    // Erase old looks first, otherwise looks removed from the file would survive the reload
+    for (const auto& name : looknfeel.objectNames)
+        CEGUI::WidgetLookManager::getSingleton().eraseWidgetLook(CEGUIUtils::qStringToString(name));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CEGUI::WidgetLookManager::getSingleton().parseLookNFeelSpecificationFromFile(CEGUIUtils::qStringToString(looknfeel.fileName),
+                                                                                CEGUIUtils::qStringToString(looknfeel.resourceGroup));
+
+    _syncTimings.addRecord(CEGUISyncTimings::Stage::LookNFeelParse, schemeFile, looknfeel.fileName, timer.nsecsElapsed());
+
+    looknfeel = _resourceTracker.trackResource(*currentProject, CEGUIResourceTracker::ResourceType::LookNFeel,
+                                               looknfeel.fileName, looknfeel.resourceGroup);
+}
+
+// Loads resources the layout references if they were deferred by lazy loading. References are
+// found among all attribute values and texts, so that no knowledge of property types is needed.
+void CEGUIManager::ensureLayoutResources(const QString& layoutXml)
+{
+    if (!_resourceTracker.hasDeferredResources()) return;
+
+    QSet<QString> values;
+    QXmlStreamReader xml(layoutXml);
+    while (!xml.atEnd())
+    {
+        const auto token = xml.readNext();
+        if (token == QXmlStreamReader::StartElement)
+        {
+            for (const auto& attr : xml.attributes())
+                values.insert(attr.value().toString());
+        }
+        else if (token == QXmlStreamReader::Characters && !xml.isWhitespace())
+        {
+            values.insert(xml.text().toString().trimmed());
         }
     }
-    catch (const std::exception& e)
+
+    loadDeferredReferences(values);
+}
+
+void CEGUIManager::ensureWidgetTypeResources(const QString& widgetType)
+{
+    if (_resourceTracker.hasDeferredResources())
+        loadDeferredReferences({ widgetType });
+}
+
+void CEGUIManager::ensurePropertyValueResources(const QString& value)
+{
+    if (_resourceTracker.hasDeferredResources())
+        loadDeferredReferences({ value });
+}
+
+// Whether anything the value refers to is still waiting to be loaded on demand
+bool CEGUIManager::hasDeferredResources(const QString& value) const
+{
+    if (!_resourceTracker.hasDeferredResources()) return false;
+
+    std::vector<std::pair<CEGUIResourceTracker::ResourceType, DeferredResource>> pending;
+    findDeferredReferences({ value }, pending);
+    return !pending.empty();
+}
+
+// Values may be widget types, widget look names, font names and image names
+void CEGUIManager::findDeferredReferences(const QSet<QString>& values,
+                                          std::vector<std::pair<CEGUIResourceTracker::ResourceType, DeferredResource>>& out) const
+{
+    auto addIfNotLoaded = [this, &out](CEGUIResourceTracker::ResourceType type, const QString& objectName)
     {
-        cleanCEGUIResources();
-        QMessageBox::warning(mainWnd, "Failed to synchronise embedded CEGUI to your project",
-            QString("An attempt was made to load resources related to the project being opened, "
-            "for some reason the loading didn't succeed so all resources were destroyed! "
-            "The most likely reason is that the resource directories are wrong, this can "
-            "be very easily remedied in the project settings.\n\n"
-            "This means that editing capabilities of CEED will be limited to editing of files "
-            "that don't require a project opened (for example: imagesets).\nException: %1").arg(e.what()));
-        result = false;
+        auto resource = _resourceTracker.findDeferredResource(type, objectName);
+        if (resource && !_resourceTracker.findResource(type, resource->fileName))
+            out.emplace_back(type, *resource);
+    };
+
+    auto& windowFactoryMgr = CEGUI::WindowFactoryManager::getSingleton();
+
+    for (const auto& value : values)
+    {
+        if (value.isEmpty()) continue;
+
+        addIfNotLoaded(CEGUIResourceTracker::ResourceType::LookNFeel, value);
+        addIfNotLoaded(CEGUIResourceTracker::ResourceType::Font, value);
+
+        // Both image names and mapped widget types are prefixed
+        const int sepPos = value.indexOf('/');
+        if (sepPos <= 0) continue;
+
+        addIfNotLoaded(CEGUIResourceTracker::ResourceType::Imageset, value.left(sepPos));
+
+        const CEGUI::String windowType = windowFactoryMgr.getDereferencedAliasType(CEGUIUtils::qStringToString(value));
+        if (windowFactoryMgr.isFalagardMappedType(windowType))
+            addIfNotLoaded(CEGUIResourceTracker::ResourceType::LookNFeel,
+                           CEGUIUtils::stringToQString(windowFactoryMgr.getMappedLookForType(windowType)));
     }
+}
 
-    // Put SchemeManager into the default state again
-    CEGUI::SchemeManager::getSingleton().setAutoLoadResources(true);
+// Loads deferred resources the values refer to along with everything loaded looks refer to in turn
+void CEGUIManager::loadDeferredReferences(const QSet<QString>& values)
+{
+    std::vector<std::pair<CEGUIResourceTracker::ResourceType, DeferredResource>> pending;
+    findDeferredReferences(values, pending);
 
-    doneOpenGLContextCurrent();
+    // Windows outside of a GUI context have no default font, give them at least one
+    if (!_lazyDefaultFont.isEmpty() && CEGUI::FontManager::getSingleton().getRegisteredFonts().empty())
+        findDeferredReferences({ _lazyDefaultFont }, pending);
 
-    progress.reset();
-    QApplication::instance()->processEvents();
+    if (pending.empty()) return;
 
-    return result;
+    // Can be called from within a rendering code of another context
+    QOpenGLContext* prevContext = QOpenGLContext::currentContext();
+    QSurface* prevSurface = prevContext ? prevContext->surface() : nullptr;
+    makeOpenGLContextCurrent();
+
+    QStringList errors;
+    while (!pending.empty())
+    {
+        const auto type = pending.back().first;
+        const DeferredResource resource = pending.back().second;
+        pending.pop_back();
+
+        // The same file may be requested through different objects it defines
+        if (_resourceTracker.findResource(type, resource.fileName)) continue;
+
+        // Scheme is not loaded yet or its loading has failed
+        auto scheme = _resourceTracker.findScheme(resource.schemeFile);
+        if (!scheme) continue;
+
+        try
+        {
+            switch (type)
+            {
+                case CEGUIResourceTracker::ResourceType::Imageset:
+                {
+                    const QString group = resource.resourceGroup.isEmpty() ? "imagesets" : resource.resourceGroup;
+                    _textureDecoder.enqueueImageset(currentProject->getResourceFilePath(resource.fileName, group));
+                    loadSchemeImageset(*scheme, resource.fileName, resource.resourceGroup);
+                    break;
+                }
+                case CEGUIResourceTracker::ResourceType::Font:
+                {
+                    loadSchemeFont(*scheme, resource.fileName, resource.resourceGroup);
+                    break;
+                }
+                case CEGUIResourceTracker::ResourceType::LookNFeel:
+                {
+                    loadSchemeLookNFeel(*scheme, resource.fileName, resource.resourceGroup);
+
+                    // Looks refer to images, fonts, looks they inherit and types of their child widgets
+                    QSet<QString> lookValues;
+                    for (const auto& attrs : _resourceCache.readElementAttributes(scheme->looknfeels.back().files[0].first, QString()))
+                        for (const auto& attr : attrs)
+                            lookValues.insert(attr.value().toString());
+                    findDeferredReferences(lookValues, pending);
+                    break;
+                }
+                default: break;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            errors.append(QString("%1: %2").arg(resource.fileName, e.what()));
+        }
+    }
+
+    if (prevContext)
+        prevContext->makeCurrent(prevSurface);
+    else
+        doneOpenGLContextCurrent();
+
+    // Nothing already loaded has changed, previews and property schemas stay valid
+    ++_resourceLoadGeneration;
+
+    if (debugInfo) debugInfo->updateSyncTimings();
+
+    if (!errors.isEmpty())
+        QMessageBox::warning(qobject_cast<Application*>(qApp)->getMainWindow(), "Failed to load project resources on demand",
+                             "Some resources couldn't be loaded, widgets using them may fail to be created.\n\n" + errors.join('\n'));
 }
 
 // Destroy all previous resources (if any)
@@ -598,6 +1176,10 @@ void CEGUIManager::cleanCEGUIResources()
     CEGUI::System::getSingleton().addStandardWindowFactories();
     CEGUI::System::getSingleton().getRenderer()->destroyAllTextures();
 
+    _resourceTracker.clear();
+    ++_resourceGeneration;
+    ++_resourceLoadGeneration;
+
     doneOpenGLContextCurrent();
 }
 
@@ -636,6 +1218,11 @@ QStringList CEGUIManager::getAvailableFonts() const
         fonts.append(CEGUIUtils::stringToQString(pair.first));
     }
 
+    // Fonts not loaded yet in lazy mode
+    for (const auto& fontName : _resourceTracker.getDeferredResourceNames(CEGUIResourceTracker::ResourceType::Font))
+        if (!fonts.contains(fontName))
+            fonts.append(fontName);
+
     std::sort(fonts.begin(), fonts.end());
     return fonts;
 }
@@ -653,6 +1240,19 @@ QStringList CEGUIManager::getAvailableImages() const
         ++it;
     }
 
+    // Images of imagesets not loaded yet in lazy mode are read from their descriptors
+    for (const auto& imagesetName : _resourceTracker.getDeferredResourceNames(CEGUIResourceTracker::ResourceType::Imageset))
+    {
+        auto resource = _resourceTracker.findDeferredResource(CEGUIResourceTracker::ResourceType::Imageset, imagesetName);
+        if (_resourceTracker.findResource(CEGUIResourceTracker::ResourceType::Imageset, resource->fileName))
+            continue;
+
+        const QString group = resource->resourceGroup.isEmpty() ? "imagesets" : resource->resourceGroup;
+        const QString filePath = currentProject->getResourceFilePath(resource->fileName, group);
+        for (const auto& attrs : _resourceCache.readElementAttributes(filePath, "Image"))
+            images.append(imagesetName + '/' + attrs.value("name").toString());
+    }
+
     std::sort(images.begin(), images.end());
     return images;
 }
@@ -692,28 +1292,202 @@ void CEGUIManager::getAvailableWidgetsBySkin(std::map<QString, QStringList>& out
 }
 
 // Renders and retrieves a widget preview QImage. This is useful for various widget selection lists as a preview.
+// Previews are cached until project resources change. The render target is reused while the size is the same.
 QImage CEGUIManager::getWidgetPreviewImage(const QString& widgetType, int previewWidth, int previewHeight)
 {
     ensureCEGUIInitialized();
+    ensureWidgetTypeResources(widgetType);
+    validateWidgetPreviews();
+
+    const QString previewKey = QString("%1|%2x%3").arg(widgetType).arg(previewWidth).arg(previewHeight);
+    auto it = _widgetPreviews.find(previewKey);
+    if (it != _widgetPreviews.end()) return it.value();
+
+    auto widgetInstance = createPreviewWindow(widgetType, static_cast<float>(previewWidth), static_cast<float>(previewHeight));
+
+    makeOpenGLContextCurrent();
+
+    ensureOffscreenTarget(_previewTarget, previewWidth, previewHeight);
+    widgetInstance->setRenderingSurface(_previewTarget.surface);
+
+    _previewTarget.fbo->bind();
+
+    glContext->functions()->glClearColor(0.9f, 0.9f, 0.9f, 1.f);
+    glContext->functions()->glClear(GL_COLOR_BUFFER_BIT);
+
+    auto renderer = CEGUI::System::getSingleton().getRenderer();
+    renderer->beginRendering();
+
+    QString error;
+    try
+    {
+        widgetInstance->draw();
+    }
+    catch (const std::exception& e)
+    {
+        error = e.what();
+    }
+
+    renderer->endRendering();
+    _previewTarget.fbo->release();
+
+    QImage result = _previewTarget.fbo->toImage();
+
+    // The surface outlives the window, it must not keep its geometry
+    _previewTarget.surface->clearGeometry();
+    widgetInstance->setRenderingSurface(nullptr);
+    CEGUI::WindowManager::getSingleton().destroyWindow(widgetInstance);
+
+    doneOpenGLContextCurrent();
+
+    if (!error.isEmpty())
+        throw error;
+
+    _widgetPreviews.insert(previewKey, result);
+
+    return result;
+}
+
+// Thumbnails not cached yet are rendered in one batch into a shared atlas with a single readback. They
+// are also stored in the project cache, unless resources are loaded on demand and thus change all the time.
+// Null images are returned for types which can't be rendered and for types whose resources are not loaded
+// yet, thumbnails alone are not worth loading them on demand.
+std::vector<QImage> CEGUIManager::getWidgetThumbnails(const QStringList& widgetTypes, int width, int height)
+{
+    ensureCEGUIInitialized();
+    validateWidgetPreviews();
+
+    const QByteArray stateHash = _lazyLoading ? QByteArray() : getResourceStateHash();
+
+    std::vector<QImage> result(static_cast<size_t>(widgetTypes.size()));
+    std::vector<int> missing;
+    for (int i = 0; i < widgetTypes.size(); ++i)
+    {
+        const QString previewKey = QString("%1|%2x%3").arg(widgetTypes[i]).arg(width).arg(height);
+        QImage image = _widgetPreviews.value(previewKey);
+        if (image.isNull() && !stateHash.isEmpty())
+        {
+            image = _resourceCache.loadThumbnail(stateHash, previewKey);
+            if (!image.isNull()) _widgetPreviews.insert(previewKey, image);
+        }
+
+        if (!image.isNull())
+            result[static_cast<size_t>(i)] = image;
+        else if (!hasDeferredResources(widgetTypes[i]))
+            missing.push_back(i);
+    }
+
+    if (missing.empty()) return result;
+
+    const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(missing.size()))));
+    const int rows = (static_cast<int>(missing.size()) + columns - 1) / columns;
+
+    // All widgets are children of one root sharing the atlas surface and are drawn at once
+    auto& windowManager = CEGUI::WindowManager::getSingleton();
+    auto root = windowManager.createWindow("DefaultWindow", "thumbnails");
+    root->setSize(CEGUI::USize(CEGUI::UDim(0.f, static_cast<float>(columns * width)), CEGUI::UDim(0.f, static_cast<float>(rows * height))));
+
+    std::vector<std::pair<int, QPoint>> cells;
+    for (size_t i = 0; i < missing.size(); ++i)
+    {
+        const QPoint cell((static_cast<int>(i) % columns) * width, (static_cast<int>(i) / columns) * height);
+        try
+        {
+            auto widgetInstance = createPreviewWindow(widgetTypes[missing[i]], static_cast<float>(width), static_cast<float>(height));
+            widgetInstance->setName(CEGUIUtils::qStringToString(QString("thumbnail%1").arg(i))); // Siblings must have unique names
+            widgetInstance->setPosition(CEGUI::UVector2(CEGUI::UDim(0.f, static_cast<float>(cell.x())), CEGUI::UDim(0.f, static_cast<float>(cell.y()))));
+            root->addChild(widgetInstance);
+            cells.emplace_back(missing[i], cell);
+        }
+        catch (const std::exception&)
+        {
+            // Unknown or broken type, no thumbnail for it
+        }
+    }
 
-    const float previewWidthF = static_cast<float>(previewWidth);
-    const float previewHeightF = static_cast<float>(previewHeight);
+    root->update(1.f);
+
+    makeOpenGLContextCurrent();
+
+    ensureOffscreenTarget(_thumbnailAtlas, columns * width, rows * height);
+    root->setRenderingSurface(_thumbnailAtlas.surface);
+
+    _thumbnailAtlas.fbo->bind();
+
+    glContext->functions()->glClearColor(0.9f, 0.9f, 0.9f, 1.f);
+    glContext->functions()->glClear(GL_COLOR_BUFFER_BIT);
+
+    auto renderer = CEGUI::System::getSingleton().getRenderer();
+    renderer->beginRendering();
+
+    bool rendered = true;
+    try
+    {
+        root->draw();
+    }
+    catch (const std::exception&)
+    {
+        rendered = false;
+    }
+
+    renderer->endRendering();
+    _thumbnailAtlas.fbo->release();
+
+    const QImage atlas = rendered ? _thumbnailAtlas.fbo->toImage() : QImage();
+
+    _thumbnailAtlas.surface->clearGeometry();
+    root->setRenderingSurface(nullptr);
+    windowManager.destroyWindow(root);
+
+    doneOpenGLContextCurrent();
+
+    if (atlas.isNull()) return result;
+
+    for (const auto& cell : cells)
+    {
+        const QImage image = atlas.copy(QRect(cell.second, QSize(width, height)));
+        const QString previewKey = QString("%1|%2x%3").arg(widgetTypes[cell.first]).arg(width).arg(height);
+        _widgetPreviews.insert(previewKey, image);
+        if (!stateHash.isEmpty()) _resourceCache.storeThumbnail(stateHash, previewKey, image);
+        result[static_cast<size_t>(cell.first)] = image;
+    }
+
+    return result;
+}
+
+// Must be called with the CEGUI OpenGL context current
+void CEGUIManager::ensureOffscreenTarget(OffscreenTarget& target, int width, int height)
+{
+    if (target.fbo && target.fbo->width() == width && target.fbo->height() == height) return;
+
+    releaseOffscreenTarget(target);
 
-    //???allocate previews once?
     // TODO: renderer->get/createViewportTarget!
     auto renderer = static_cast<CEGUI::OpenGLRendererBase*>(CEGUI::System::getSingleton().getRenderer());
-    auto renderTarget = new CEGUI::OpenGLViewportTarget(*renderer, CEGUI::Rectf(0.f, 0.f, previewWidthF, previewHeightF));
+    target.target = new CEGUI::OpenGLViewportTarget(*renderer, CEGUI::Rectf(0.f, 0.f, static_cast<float>(width), static_cast<float>(height)));
+    target.surface = new CEGUI::RenderingSurface(*target.target);
+    target.fbo = new QOpenGLFramebufferObject(width, height);
+}
 
-    auto renderingSurface = new CEGUI::RenderingSurface(*renderTarget);
+// Must be called with the CEGUI OpenGL context current
+void CEGUIManager::releaseOffscreenTarget(OffscreenTarget& target)
+{
+    delete target.fbo;
+    target.fbo = nullptr;
+    delete target.surface;
+    target.surface = nullptr;
+    delete target.target;
+    target.target = nullptr;
+}
 
+CEGUI::Window* CEGUIManager::createPreviewWindow(const QString& widgetType, float width, float height)
+{
     auto widgetInstance = CEGUI::WindowManager::getSingleton().createWindow(CEGUIUtils::qStringToString(widgetType), "preview");
 
-    widgetInstance->setRenderingSurface(renderingSurface);
-
     // Set it's size and position so that it shows up
     // TODO: per-widget-type size! See WidgetsSample!
     widgetInstance->setPosition(CEGUI::UVector2(CEGUI::UDim(0.f, 0.f), CEGUI::UDim(0.f, 0.f)));
-    widgetInstance->setSize(CEGUI::USize(CEGUI::UDim(0.f, previewWidthF), CEGUI::UDim(0.f, previewHeightF)));
+    widgetInstance->setSize(CEGUI::USize(CEGUI::UDim(0.f, width), CEGUI::UDim(0.f, height)));
 
     // Window is not attached to a context so it has no default font. Set default.
     // TODO: if project has no fonts, create CEED-internal default font.
@@ -730,43 +1504,43 @@ QImage CEGUIManager::getWidgetPreviewImage(const QString& widgetType, int previe
     // Fake update to ensure everything is set
     widgetInstance->update(1.f);
 
-    makeOpenGLContextCurrent();
+    return widgetInstance;
+}
 
-    //???allocate once?
-    auto temporaryFBO = new QOpenGLFramebufferObject(previewWidth, previewHeight);
-    temporaryFBO->bind();
+void CEGUIManager::validateWidgetPreviews()
+{
+    if (_widgetPreviewsGeneration == _resourceGeneration) return;
 
-    glContext->functions()->glClearColor(0.9f, 0.9f, 0.9f, 1.f);
-    glContext->functions()->glClear(GL_COLOR_BUFFER_BIT);
+    _widgetPreviews.clear();
+    _widgetPreviewsGeneration = _resourceGeneration;
+}
 
-    renderer->beginRendering();
+// Hash of paths and contents of all files loaded resources were built from
+QByteArray CEGUIManager::getResourceStateHash()
+{
+    if (_resourceStateGeneration == _resourceLoadGeneration && !_resourceStateHash.isEmpty()) return _resourceStateHash;
 
-    QString error;
-    try
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    auto addResource = [&hash](const TrackedResource& resource)
     {
-        widgetInstance->draw();
-    }
-    catch (const std::exception& e)
+        for (const auto& file : resource.files)
+        {
+            hash.addData(file.first.toUtf8());
+            hash.addData(file.second.hash);
+        }
+    };
+
+    for (const auto& scheme : _resourceTracker.getSchemes())
     {
-        error = e.what();
+        addResource(scheme.schemeFiles);
+        for (const auto& resource : scheme.imagesets) addResource(resource);
+        for (const auto& resource : scheme.fonts) addResource(resource);
+        for (const auto& resource : scheme.looknfeels) addResource(resource);
     }
 
-    renderer->endRendering();
-    temporaryFBO->release();
-
-    QImage result = temporaryFBO->toImage();
-
-    delete temporaryFBO;
-    CEGUI::WindowManager::getSingleton().destroyWindow(widgetInstance);
-    delete renderingSurface;
-    delete renderTarget;
-
-    doneOpenGLContextCurrent();
-
-    if (!error.isEmpty())
-        throw error;
-
-    return result;
+    _resourceStateHash = hash.result();
+    _resourceStateGeneration = _resourceLoadGeneration;
+    return _resourceStateHash;
 }
 
 const QtnEnumInfo& CEGUIManager::enumHorizontalAlignment()
@@ -905,3 +1679,23 @@ const QtnEnumInfo& CEGUIManager::enumVerticalTextFormatting()
     }
     return *_enumVerticalTextFormatting;
 }
+
+// Built once per widget type, look and renderer, then reused by every property set of such widgets
+const CEGUIPropertySchema& CEGUIManager::getPropertySchema(const CEGUI::Window& widget)
+{
+    // Look properties are destroyed with their looks, so schemas can't survive resource reloading
+    if (_propertySchemasGeneration != _resourceGeneration)
+    {
+        _propertySchemas.clear();
+        _propertySchemasGeneration = _resourceGeneration;
+    }
+
+    const QString key = CEGUIPropertySchema::getKey(widget);
+    auto it = _propertySchemas.find(key);
+    if (it == _propertySchemas.end())
+    {
+        it = _propertySchemas.insert(key, CEGUIPropertySchema());
+        it->build(widget);
+    }
+    return *it;
+}
@@ -2,6 +2,18 @@
 #define CEGUIManager_H
 #include "qstring.h"
 #include "qimage.h"
+#include "qset.h"
+#include "qhash.h"
+#include "src/cegui/CEGUIResourceTracker.h"
+#include "src/cegui/CEGUIResourceCache.h"
+#include "src/cegui/CEGUITextureDecoder.h"
+#include "src/cegui/CEGUIProjectSyncJob.h"
+#include "src/cegui/CEGUISyncTimings.h"
+#include "src/cegui/CEGUIDependencyGraph.h"
+#include "src/cegui/CEGUIRenderTargetManager.h"
+#include "src/cegui/CEGUIFrameProfiler.h"
+#include "src/cegui/CEGUIPropertySchema.h"
+#include "qelapsedtimer.h"
 #include <memory>
 #include <functional>
 
@@ -16,6 +28,15 @@ class QOpenGLContext;
 class QOffscreenSurface;
 class RedirectingCEGUILogger;
 class CEGUIDebugInfo;
+class QOpenGLFramebufferObject;
+
+namespace CEGUI
+{
+    class Scheme;
+    class Window;
+    class RenderingSurface;
+    class OpenGLViewportTarget;
+}
 
 class CEGUIManager
 {
@@ -47,9 +68,25 @@ public:
     QStringList getAvailableImages() const;
     void getAvailableWidgetsBySkin(std::map<QString, QStringList>& out) const;
     QImage getWidgetPreviewImage(const QString& widgetType, int previewWidth = 128, int previewHeight = 64);
-
-    bool syncProjectToCEGUIInstance();
+    std::vector<QImage> getWidgetThumbnails(const QStringList& widgetTypes, int width, int height);
+    quint64 getResourceGeneration() const { return _resourceGeneration; }
+    quint64 getResourceLoadGeneration() const { return _resourceLoadGeneration; }
+
+    bool syncProjectToCEGUIInstance(bool incremental = false);
+    bool canSyncIncrementally() const;
+    QStringList getOutdatedResourceFiles();
+    void cancelSync();
+    bool isSyncInProgress() const { return _syncJob != nullptr; }
+    CEGUIProjectSyncJob* getSyncJob() const { return _syncJob; }
+    const CEGUISyncTimings& getSyncTimings() const { return _syncTimings; }
+    CEGUIDependencyGraph& getDependencyGraph() { return _dependencyGraph; }
+    CEGUIRenderTargetManager& getRenderTargetManager() { return _renderTargetManager; }
+    CEGUIFrameProfiler& getFrameProfiler() { return _frameProfiler; }
     void ensureCEGUIInitialized();
+    void ensureLayoutResources(const QString& layoutXml);
+    void ensureWidgetTypeResources(const QString& widgetType);
+    void ensurePropertyValueResources(const QString& value);
+    bool hasDeferredResources(const QString& value) const;
     bool makeOpenGLContextCurrent();
     void doneOpenGLContextCurrent();
     void showDebugInfo();
@@ -64,10 +101,41 @@ public:
     const QtnEnumInfo& enumVerticalFormatting();
     const QtnEnumInfo& enumHorizontalTextFormatting();
     const QtnEnumInfo& enumVerticalTextFormatting();
+    const CEGUIPropertySchema& getPropertySchema(const CEGUI::Window& widget);
 
 protected:
 
+    // CEGUI rendering into a Qt FBO outside of any GUI context
+    struct OffscreenTarget
+    {
+        CEGUI::OpenGLViewportTarget* target = nullptr;
+        CEGUI::RenderingSurface* surface = nullptr;
+        QOpenGLFramebufferObject* fbo = nullptr;
+    };
+
     void cleanCEGUIResources();
+    QStringList getProjectResourceDirectories() const;
+    void onSyncFinished(CEGUIProjectSyncJob::Result result, const QString& error);
+    void enqueueSchemeTextures(const QString& schemeFile);
+    void planSchemeLoading(const QString& schemeFile);
+    void planChangedResourcesReload(TrackedScheme& trackedScheme);
+    void deferSchemeResources(const QString& schemeFile);
+    void beginSchemeLoading(const QString& schemeFile);
+    void loadSchemeImageset(TrackedScheme& scheme, const QString& fileName, const QString& resourceGroup);
+    void loadSchemeFont(TrackedScheme& scheme, const QString& fileName, const QString& resourceGroup);
+    void loadSchemeLookNFeel(TrackedScheme& scheme, const QString& fileName, const QString& resourceGroup);
+    void endSchemeLoading();
+    void unloadScheme(const TrackedScheme& trackedScheme);
+    void reloadImageset(const QString& schemeFile, TrackedResource& imageset);
+    void reloadFont(const QString& schemeFile, TrackedResource& font);
+    void reloadLookNFeel(const QString& schemeFile, TrackedResource& looknfeel);
+    void findDeferredReferences(const QSet<QString>& values, std::vector<std::pair<CEGUIResourceTracker::ResourceType, DeferredResource>>& out) const;
+    void loadDeferredReferences(const QSet<QString>& values);
+    void ensureOffscreenTarget(OffscreenTarget& target, int width, int height);
+    void releaseOffscreenTarget(OffscreenTarget& target);
+    CEGUI::Window* createPreviewWindow(const QString& widgetType, float width, float height);
+    void validateWidgetPreviews();
+    QByteArray getResourceStateHash();
 
     QOpenGLContext* glContext = nullptr;
     QOffscreenSurface* surface = nullptr;
@@ -85,6 +153,30 @@ protected:
     QtnEnumInfo* _enumVerticalTextFormatting = nullptr;
 
     std::unique_ptr<CEGUIProject> currentProject;
+    mutable CEGUIResourceCache _resourceCache; // Thread safe itself, reading through it is logically const
+    CEGUIResourceTracker _resourceTracker;
+    CEGUITextureDecoder _textureDecoder;
+    CEGUIProjectSyncJob* _syncJob = nullptr;
+    CEGUISyncTimings _syncTimings;
+    CEGUIDependencyGraph _dependencyGraph;
+    CEGUIRenderTargetManager _renderTargetManager;
+    CEGUIFrameProfiler _frameProfiler;
+    QElapsedTimer _syncTimer;
+    std::unique_ptr<TrackedScheme> _pendingScheme; // Being loaded by the sync job, not tracked yet
+    CEGUI::Scheme* _pendingCEGUIScheme = nullptr;
+    QString _lazyDefaultFont; // Loaded first on demand, so that widgets always have some font
+    bool _lazyLoading = false;
+    quint64 _resourceGeneration = 0; // Changes whenever CEGUI resources are destroyed or replaced, caches built from them are invalid then
+    quint64 _resourceLoadGeneration = 0; // Changes also when resources are only added by loading on demand
+
+    QHash<QString, QImage> _widgetPreviews; // By type and size, rendered with _widgetPreviewsGeneration resources
+    quint64 _widgetPreviewsGeneration = 0;
+    QHash<QString, CEGUIPropertySchema> _propertySchemas; // By CEGUIPropertySchema::getKey, built with _propertySchemasGeneration resources
+    quint64 _propertySchemasGeneration = 0;
+    OffscreenTarget _previewTarget;
+    OffscreenTarget _thumbnailAtlas;
+    QByteArray _resourceStateHash; // Identifies content of all loaded resource files, for persistent thumbnails
+    quint64 _resourceStateGeneration = 0;
     bool initialized = false;
     bool _isOpenGL3 = false;
 };
@@ -1,17 +1,19 @@
 #include "src/cegui/CEGUIManipulator.h"
 #include "src/cegui/CEGUIUtils.h"
 #include "src/cegui/CEGUIManager.h"
+#include "src/cegui/QtnPropertyUDim.h"
 #include "src/cegui/QtnPropertyUVector2.h"
 #include "src/cegui/QtnPropertyUVector3.h"
 #include "src/cegui/QtnPropertyUSize.h"
 #include "src/cegui/QtnPropertyURect.h"
 #include "src/cegui/QtnPropertyUBox.h"
 #include "src/ui/CEGUIGraphicsScene.h"
-#include "src/util/Settings.h"
+#include "src/util/SettingsHandle.h"
 #include "src/Application.h"
 #include "qgraphicsscene.h"
 #include "qpainter.h"
 #include <qmessagebox.h>
+#include <qtimer.h>
 #include <CEGUI/widgets/TabControl.h>
 #include <CEGUI/widgets/ScrollablePane.h>
 #include <CEGUI/widgets/ScrolledContainer.h>
@@ -26,6 +28,14 @@
 #include "QtnProperty/Core/PropertyEnum.h"
 #include "QtnProperty/Delegates/Core/PropertyDelegateQString.h"
 
+// Manipulators with property sets, most recently used first. Creating a set costs dozens of QObjects
+// and a string conversion of each CEGUI property, so only a limited number of unused sets is kept.
+static std::list<CEGUIManipulator*> propertySetUsers;
+static const size_t MAX_PROPERTY_SETS = 64;
+static bool propertySetReleaseQueued = false;
+
+static SettingsHandle<bool> hideDeadEndAutoWidgets("layout/visual/hide_deadend_autowidgets");
+
 // recursive - if true, even children of given widget are wrapped
 // skipAutoWidgets - if true, auto widgets are skipped (only applicable if recursive is True)
 CEGUIManipulator::CEGUIManipulator(QGraphicsItem* parent, CEGUI::Window* widget)
@@ -33,67 +43,21 @@ CEGUIManipulator::CEGUIManipulator(QGraphicsItem* parent, CEGUI::Window* widget)
     , _widget(widget)
 {
     setFlags(ItemIsFocusable | ItemIsSelectable | ItemIsMovable | ItemSendsGeometryChanges);
-
-    createPropertySet();
 }
 
 CEGUIManipulator::~CEGUIManipulator()
 {
-    delete _propertySet;
+    releasePropertySet();
 }
 
 void CEGUIManipulator::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
     painter->save();
 
+    // We are drawing the outlines after CEGUI has already been rendered so we have to clip parts covered
+    // by manipulators above us, their widgets are rendered over our widget too
     if (preventManipulatorOverlap())
-    {
-        // NOTE: This is just an option because it's very performance intensive, most people editing big layouts will
-        //       want this disabled. But it makes editing nicer and fancier :-)
-
-        // We are drawing the outlines after CEGUI has already been rendered so he have to clip overlapping parts
-        // we basically query all items colliding with ourselves and if that's a manipulator and is over us we subtract
-        // that from the clipped path.
-        QPainterPath clipPath;
-        clipPath.addRect(QRectF(-scenePos().x(), -scenePos().y(), scene()->sceneRect().width(), scene()->sceneRect().height()));
-
-        // FIXME: I used self.collidingItems() but that seems way way slower than just going over everything on the scene
-        //        in reality we need siblings of ancestors recursively up to the top
-        //
-        //        this just begs for optimisation in the future
-        auto collidingItems = scene()->items();
-        for (QGraphicsItem* item : collidingItems)
-        {
-            if (!item->isVisible() || item == this) continue;
-
-            CEGUIManipulator* manipulator = dynamic_cast<CEGUIManipulator*>(item);
-            if (!manipulator) continue;
-
-            // Check if the item is above us
-            // FIXME: nasty nasty way to do this
-            bool isAbove = false;
-            for (QGraphicsItem* itm : scene()->items())
-            {
-                if (itm == this)
-                {
-                    isAbove = true;
-                    break;
-                }
-                else if (itm == item) break;
-            }
-
-            if (isAbove)
-            {
-                QPainterPath boundingClipPath;
-                boundingClipPath.addRect(item->boundingRect());
-                clipPath = clipPath.subtracted(boundingClipPath.translated(item->scenePos() - scenePos()));
-            }
-        }
-
-        // We clip using stencil buffers to prevent overlapping outlines appearing
-        // FIXME: This could potentially get very slow for huge layouts
-        painter->setClipPath(clipPath);
-    }
+        painter->setClipPath(getOverlapClipPath(), Qt::IntersectClip);
 
     impl_paint(painter, option, widget);
 
@@ -219,6 +183,19 @@ bool CEGUIManipulator::isInLayoutContainer() const
     return dynamic_cast<CEGUI::LayoutContainer*>(_widget->getParent());
 }
 
+// In case of nested LCs the outermost one lays out all of them
+CEGUIManipulator* CEGUIManipulator::getTopmostAncestorLC() const
+{
+    CEGUIManipulator* topmostLC = nullptr;
+    auto item = parentItem();
+    while (item && static_cast<CEGUIManipulator*>(item)->isLayoutContainer())
+    {
+        topmostLC = static_cast<CEGUIManipulator*>(item);
+        item = item->parentItem();
+    }
+    return topmostLC;
+}
+
 QSizeF CEGUIManipulator::getMinSize() const
 {
     if (_widget)
@@ -595,17 +572,9 @@ void CEGUIManipulator::updateFromWidget(bool callUpdate, bool updateAncestorLCs)
     if (updateAncestorLCs)
     {
         // We are trying to find a topmost LC (in case of nested LCs) and recursively update it
-        QGraphicsItem* topmostLC = nullptr;
-        auto item = parentItem();
-        while (item && static_cast<CEGUIManipulator*>(item)->isLayoutContainer())
-        {
-            topmostLC = item;
-            item = item->parentItem();
-        }
-
-        if (topmostLC)
+        if (auto topmostLC = getTopmostAncestorLC())
         {
-            static_cast<CEGUIManipulator*>(topmostLC)->updateFromWidget(true, false);
+            topmostLC->updateFromWidget(true, false);
 
             // No need to continue, this method will get called again with updateAncestorLCs = false
             return;
@@ -793,6 +762,7 @@ void CEGUIManipulator::createChildManipulators(bool recursive, bool skipAutoWidg
 void CEGUIManipulator::moveToFront()
 {
     _widget->moveToFront();
+    invalidateOverlapClipping();
 
     if (!parentItem()) return;
 
@@ -811,13 +781,13 @@ void CEGUIManipulator::updatePropertiesFromWidget(const QStringList& propertyNam
         auto it = _propertyMap.find(propertyName);
         if (it != _propertyMap.end())
         {
-            const CEGUI::Property* ceguiProp = it->second.first;
-            QtnProperty* prop = it->second.second;
-            prop->fromStr(CEGUIUtils::stringToQString(ceguiProp->get(_widget)));
-
-            if (propertyName == "Name")
-                onWidgetNameChanged();
+            const auto& binding = it->second;
+            CEGUIPropertyBridge::read(binding.accessors.reader, *binding.ceguiProperty, *_widget, *binding.property);
         }
+
+        // Without a property set there is nothing else to update, it will be created from actual values
+        if (propertyName == "Name")
+            onWidgetNameChanged();
     }
 }
 
@@ -825,246 +795,259 @@ void CEGUIManipulator::updateAllPropertiesFromWidget()
 {
     for (const auto& pair : _propertyMap)
     {
-        const CEGUI::Property* ceguiProp = pair.second.first;
-        QtnProperty* prop = pair.second.second;
-        prop->fromStr(CEGUIUtils::stringToQString(ceguiProp->get(_widget)));
+        const auto& binding = pair.second;
+        CEGUIPropertyBridge::read(binding.accessors.reader, *binding.ceguiProperty, *_widget, *binding.property);
     }
 
     onWidgetNameChanged();
 }
 
-void CEGUIManipulator::createPropertySet()
+// Creates the set on the first request. Each request marks the set as recently used.
+QtnPropertySet* CEGUIManipulator::getPropertySet()
+{
+    if (_propertySet)
+    {
+        propertySetUsers.splice(propertySetUsers.begin(), propertySetUsers, _propertySetUseIt);
+        return _propertySet;
+    }
+
+    createPropertySet();
+    if (!_propertySet) return nullptr;
+
+    propertySetUsers.push_front(this);
+    _propertySetUseIt = propertySetUsers.begin();
+
+    // Not right now, the caller may be replacing a set shown in the property view with this one
+    if (propertySetUsers.size() > MAX_PROPERTY_SETS && !propertySetReleaseQueued)
+    {
+        propertySetReleaseQueued = true;
+        QTimer::singleShot(0, qApp, &CEGUIManipulator::releaseUnusedPropertySets);
+    }
+
+    return _propertySet;
+}
+
+void CEGUIManipulator::releasePropertySet()
 {
+    if (!_propertySet) return;
+
+    propertySetUsers.erase(_propertySetUseIt);
     _propertyMap.clear();
-    if (_propertySet) delete _propertySet;
+    delete _propertySet;
+    _propertySet = nullptr;
+}
 
-    if (!_widget)
+// Sets of selected manipulators are never released, the property view and the multi-selection
+// set of the layout scene may refer to them
+void CEGUIManipulator::releaseUnusedPropertySets()
+{
+    propertySetReleaseQueued = false;
+
+    auto it = propertySetUsers.end();
+    while (propertySetUsers.size() > MAX_PROPERTY_SETS && it != propertySetUsers.begin())
     {
-        _propertySet = nullptr;
+        CEGUIManipulator* manipulator = *(--it);
+        if (manipulator->isSelected()) continue;
+
+        // The next element stays valid when this one is erased
+        ++it;
+        manipulator->releasePropertySet();
+    }
+}
+
+// Clip paths of manipulators overlapping our previous or current area, ours included, are built anew
+// when painted. Our children move and restack with us and lie within that area too. Removal from the
+// scene is handled before it happens, scenes delete their items only all at once.
+void CEGUIManipulator::invalidateOverlapClipping()
+{
+    _overlapClipValid = false;
+
+    if (!scene())
+    {
+        _overlapArea = QRectF();
         return;
     }
 
-    _propertySet = new QtnPropertySet(nullptr);
+    const QRectF newArea = sceneBoundingRect() | mapRectToScene(childrenBoundingRect());
+    for (const QRectF& area : { _overlapArea, newArea })
+    {
+        if (area.isEmpty()) continue;
+
+        for (QGraphicsItem* item : scene()->items(area, Qt::IntersectsItemBoundingRect))
+            if (auto manipulator = dynamic_cast<CEGUIManipulator*>(item))
+                manipulator->_overlapClipValid = false;
+    }
+
+    _overlapArea = newArea;
+}
 
-    std::map<QString, QtnPropertySet*> subsets;
-    auto it = _widget->getPropertyIterator();
-    while (!it.isAtEnd())
+void CEGUIManipulator::notifyRectChanged()
+{
+    ResizableRectItem::notifyRectChanged();
+    invalidateOverlapClipping();
+}
+
+// Our bounding rect minus rects of visible manipulators stacked above us. Only items overlapping
+// us are queried from the scene index, and they come sorted in stacking order. The query rect is
+// deflated by the pen width, so that siblings merely touching our edges don't clip our outline.
+const QPainterPath& CEGUIManipulator::getOverlapClipPath()
+{
+    if (_overlapClipValid) return _overlapClipPath;
+
+    const QRectF ownRect = boundingRect();
+    const qreal penWidth = pen().widthF();
+    const QRectF queryRect = mapRectToScene(rect().adjusted(penWidth, penWidth, -penWidth, -penWidth));
+
+    // An empty query rect means we are too small to be overlapped by anything but outlines
+    QList<QGraphicsItem*> candidates;
+    if (!queryRect.isEmpty())
+        candidates = scene()->items(queryRect, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder);
+
+    QPainterPath coveredPath;
+    coveredPath.setFillRule(Qt::WindingFill); // Union of all rects added
+    for (QGraphicsItem* item : candidates)
     {
-        CEGUI::Property* ceguiProp = it.getCurrentValue();
+        // Everything after us is below
+        if (item == this) break;
 
-        if (!ceguiProp->isReadable())
-        {
-            ++it;
-            continue;
-        }
+        if (!item->isVisible()) continue;
 
-        // Categorize properties by CEGUI property origin
-        QtnPropertySet* parentSet = _propertySet;
-        QString category = CEGUIUtils::stringToQString(ceguiProp->getOrigin());
-        if (category.startsWith("CEGUI/")) category = category.mid(6);
-        if (!category.isEmpty())
-        {
-            auto it = subsets.find(category);
-            if (it == subsets.end())
-            {
-                // Insertion delayed for sorting, see below
-                parentSet = new QtnPropertySet(_propertySet);
-                parentSet->setName(category);
-                subsets.emplace(std::move(category), parentSet);
-            }
-            else parentSet = it->second;
-        }
+        auto manipulator = dynamic_cast<CEGUIManipulator*>(item);
+        if (!manipulator) continue;
 
-        QtnProperty* prop = nullptr;
-        const auto& propertyDataType = ceguiProp->getDataType(); // could be overridden through a property map
-        if (propertyDataType == "bool")
-            prop = new QtnPropertyBool(parentSet);
-        else if (propertyDataType == "std::uint32_t")
-        {
-            auto uintProp = new QtnPropertyUInt(parentSet);
-            uintProp->setDefaultValue(CEGUI::PropertyHelper<std::uint32_t>().fromString(ceguiProp->getDefault(_widget)));
-            prop = uintProp;
-        }
-        else if (propertyDataType == "float")
-        {
-            auto floatProp = new QtnPropertyFloat(parentSet);
-            floatProp->setDefaultValue(CEGUI::PropertyHelper<float>().fromString(ceguiProp->getDefault(_widget)));
-            prop = floatProp;
-        }
-        else if (propertyDataType == "HorizontalAlignment")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumHorizontalAlignment());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "VerticalAlignment")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumVerticalAlignment());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "AspectMode")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumAspectMode());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "DefaultParagraphDirection")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumDefaultParagraphDirection());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "WindowUpdateMode")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumWindowUpdateMode());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "VerticalFormatting")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumVerticalFormatting());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "HorizontalFormatting")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumHorizontalFormatting());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "VerticalTextFormatting")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumVerticalTextFormatting());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "HorizontalTextFormatting")
-        {
-            auto enumProp = new QtnPropertyEnum(parentSet);
-            enumProp->setEnumInfo(&CEGUIManager::Instance().enumHorizontalTextFormatting());
-            prop = enumProp;
-        }
-        else if (propertyDataType == "Font")
-        {
-            prop = new QtnPropertyQString(parentSet);
-            prop->setDelegateInfo({"Callback"});
+        coveredPath.addRect(manipulator->rect().translated(manipulator->scenePos() - scenePos()).intersected(ownRect));
+    }
 
-            //???FIXME: Qtn - can use central string list without per-property copying?
-            QtnGetCandidatesFn getCb = []() { return CEGUIManager::Instance().getAvailableFonts(); };
-            prop->setDelegateAttribute("GetCandidatesFn", QVariant::fromValue(getCb));
+    _overlapClipPath = QPainterPath();
+    _overlapClipPath.addRect(ownRect);
+    if (!coveredPath.isEmpty())
+        _overlapClipPath = _overlapClipPath.subtracted(coveredPath);
 
-            QtnCreateCandidateFn createCb = [](QWidget* /*parent*/, QString /*candidate*/) { return QString{}; };
-            prop->setDelegateAttribute("CreateCandidateFn", QVariant::fromValue(createCb));
-        }
-        else if (propertyDataType == "Image")
-        {
-            prop = new QtnPropertyQString(parentSet);
-            prop->setDelegateInfo({"Callback"});
+    _overlapClipValid = true;
+    return _overlapClipPath;
+}
 
-            //???FIXME: Qtn - can use central string list without per-property copying?
-            QtnGetCandidatesFn getCb = []() { return CEGUIManager::Instance().getAvailableImages(); };
-            prop->setDelegateAttribute("GetCandidatesFn", QVariant::fromValue(getCb));
+void CEGUIManipulator::createPropertySet()
+{
+    assert(!_propertySet && _propertyMap.empty());
 
-            QtnCreateCandidateFn createCb = [](QWidget* /*parent*/, QString /*candidate*/) { return QString{}; };
-            prop->setDelegateAttribute("CreateCandidateFn", QVariant::fromValue(createCb));
-        }
-        else if (propertyDataType == "UVector2")
-            prop = new QtnPropertyUVector2(parentSet);
-        else if (propertyDataType == "UVector3")
-            prop = new QtnPropertyUVector3(parentSet);
-        else if (propertyDataType == "USize")
-            prop = new QtnPropertyUSize(parentSet);
-        else if (propertyDataType == "URect")
-            prop = new QtnPropertyURect(parentSet);
-        else if (propertyDataType == "UBox")
-            prop = new QtnPropertyUBox(parentSet);
-        else if (propertyDataType == "vec2")
-        {
-            // TODO: implement
-            prop = new QtnPropertyQString(parentSet);
-        }
-        else if (propertyDataType == "Rectf")
-        {
-            // TODO: implement
-            prop = new QtnPropertyQString(parentSet);
-        }
-        else if (propertyDataType == "quat")
-        {
-            // TODO: implement
-            prop = new QtnPropertyQString(parentSet);
-        }
-        else if (propertyDataType == "ColourRect")
-        {
-            // TODO: implement
-            //!!!4x Color subproperty!
-            //!!!Preview rect. OpenGL triangles rendering? Or QPainter handles gradient?
-            prop = new QtnPropertyQString(parentSet);
-        }
-        else if (propertyDataType == "NumOfTextLinesToShow")
+    if (!_widget) return;
+
+    // Data types, categories and defaults are resolved once per widget type, here we only instantiate them
+    const CEGUIPropertySchema& schema = CEGUIManager::Instance().getPropertySchema(*_widget);
+
+    _propertySet = new QtnPropertySet(nullptr);
+
+    for (const auto& category : schema.categories)
+    {
+        QtnPropertySet* parentSet = _propertySet;
+        if (!category.name.isEmpty())
         {
-            // TODO: implement
-            prop = new QtnPropertyQString(parentSet);
+            parentSet = new QtnPropertySet(_propertySet);
+            parentSet->setName(category.name);
         }
-        else // "String" and any other
+
+        for (const auto& schemaProp : category.properties)
         {
-            if (propertyDataType != "String")
+            CEGUI::Property* ceguiProp = schemaProp.ceguiProperty;
+
+            QtnProperty* prop = nullptr;
+            switch (schemaProp.kind)
             {
-                assert(false && "propertyDataType unknown");
-            }
-            prop = new QtnPropertyQString(parentSet);
-        }
+                case CEGUIPropertySchema::Kind::Bool:
+                    prop = new QtnPropertyBool(parentSet);
+                    break;
+                case CEGUIPropertySchema::Kind::UInt:
+                {
+                    auto uintProp = new QtnPropertyUInt(parentSet);
+                    uintProp->setDefaultValue(schemaProp.defaultValue.toUInt());
+                    prop = uintProp;
+                    break;
+                }
+                case CEGUIPropertySchema::Kind::Float:
+                {
+                    auto floatProp = new QtnPropertyFloat(parentSet);
+                    floatProp->setDefaultValue(schemaProp.defaultValue.toFloat());
+                    prop = floatProp;
+                    break;
+                }
+                case CEGUIPropertySchema::Kind::Enum:
+                {
+                    auto enumProp = new QtnPropertyEnum(parentSet);
+                    enumProp->setEnumInfo(schemaProp.enumInfo);
+                    prop = enumProp;
+                    break;
+                }
+                case CEGUIPropertySchema::Kind::Font:
+                {
+                    prop = new QtnPropertyQString(parentSet);
+                    prop->setDelegateInfo({"Callback"});
 
-        /*
-        "SortMode": ceguitypes.SortMode,
-        "Colour": ceguitypes.Colour,
-        */
+                    //???FIXME: Qtn - can use central string list without per-property copying?
+                    QtnGetCandidatesFn getCb = []() { return CEGUIManager::Instance().getAvailableFonts(); };
+                    prop->setDelegateAttribute("GetCandidatesFn", QVariant::fromValue(getCb));
 
-        prop->setName(CEGUIUtils::stringToQString(ceguiProp->getName()));
-        prop->setDescription(CEGUIUtils::stringToQString(ceguiProp->getHelp()));
-        prop->fromStr(CEGUIUtils::stringToQString(ceguiProp->get(_widget)));
-        prop->addState(QtnPropertyStateCollapsed);
-        if (!ceguiProp->isWritable())
-            prop->addState(QtnPropertyStateImmutable);
+                    QtnCreateCandidateFn createCb = [](QWidget* /*parent*/, QString /*candidate*/) { return QString{}; };
+                    prop->setDelegateAttribute("CreateCandidateFn", QVariant::fromValue(createCb));
+                    break;
+                }
+                case CEGUIPropertySchema::Kind::Image:
+                {
+                    prop = new QtnPropertyQString(parentSet);
+                    prop->setDelegateInfo({"Callback"});
 
-        parentSet->addChildProperty(prop, true);
+                    //???FIXME: Qtn - can use central string list without per-property copying?
+                    QtnGetCandidatesFn getCb = []() { return CEGUIManager::Instance().getAvailableImages(); };
+                    prop->setDelegateAttribute("GetCandidatesFn", QVariant::fromValue(getCb));
 
-        QObject::connect(prop, &QtnProperty::propertyDidChange, [this, prop, ceguiProp](QtnPropertyChangeReason reason)
-        {
-            if (reason & QtnPropertyChangeReasonEditValue)
-                onPropertyChanged(prop, ceguiProp);
-        });
+                    QtnCreateCandidateFn createCb = [](QWidget* /*parent*/, QString /*candidate*/) { return QString{}; };
+                    prop->setDelegateAttribute("CreateCandidateFn", QVariant::fromValue(createCb));
+                    break;
+                }
+                case CEGUIPropertySchema::Kind::UDim:
+                    prop = new QtnPropertyUDim(parentSet);
+                    break;
+                case CEGUIPropertySchema::Kind::UVector2:
+                    prop = new QtnPropertyUVector2(parentSet);
+                    break;
+                case CEGUIPropertySchema::Kind::UVector3:
+                    prop = new QtnPropertyUVector3(parentSet);
+                    break;
+                case CEGUIPropertySchema::Kind::USize:
+                    prop = new QtnPropertyUSize(parentSet);
+                    break;
+                case CEGUIPropertySchema::Kind::URect:
+                    prop = new QtnPropertyURect(parentSet);
+                    break;
+                case CEGUIPropertySchema::Kind::UBox:
+                    prop = new QtnPropertyUBox(parentSet);
+                    break;
+                default:
+                    prop = new QtnPropertyQString(parentSet);
+                    break;
+            }
 
-        _propertyMap.emplace(prop->name(), std::pair<CEGUI::Property*, QtnProperty*>{ ceguiProp, prop });
+            prop->setName(schemaProp.name);
+            prop->setDescription(schemaProp.help);
+            CEGUIPropertyBridge::read(schemaProp.accessors.reader, *ceguiProp, *_widget, *prop);
+            prop->addState(QtnPropertyStateCollapsed);
+            if (!schemaProp.writable)
+                prop->addState(QtnPropertyStateImmutable);
 
-        ++it;
-    }
+            parentSet->addChildProperty(prop, true);
 
-    // We want to see some categories at the beginning of the list
-    const QStringList fixedOrderFirst = { "Element", "NamedElement", "Window" };
-    for (const QString& name : fixedOrderFirst)
-    {
-        auto itSet = subsets.find(name);
-        if (itSet != subsets.end())
-        {
-            _propertySet->addChildProperty(itSet->second, true);
-            subsets.erase(itSet);
+            QObject::connect(prop, &QtnProperty::propertyDidChange, [this, prop, ceguiProp](QtnPropertyChangeReason reason)
+            {
+                if (reason & QtnPropertyChangeReasonEditValue)
+                    onPropertyChanged(prop, ceguiProp);
+            });
+
+            _propertyMap.emplace(prop->name(), PropertyBinding{ ceguiProp, prop, schemaProp.accessors });
         }
-    }
 
-    // Unknown is always the last
-    QtnPropertySet* unknownSet = nullptr;
-    auto itSet = subsets.find("Unknown");
-    if (itSet != subsets.end())
-    {
-        unknownSet = itSet->second;
-        subsets.erase(itSet);
+        // Categories are already in the order we want to see them
+        if (parentSet != _propertySet) _propertySet->addChildProperty(parentSet, true);
     }
-
-    for (const auto& pair : subsets)
-        _propertySet->addChildProperty(pair.second, true);
-
-    if (unknownSet) _propertySet->addChildProperty(unknownSet, true);
 }
 
 void CEGUIManipulator::adjustPositionDeltaOnResize(CEGUI::UVector2& deltaPos, const CEGUI::USize& deltaSize)
@@ -1096,10 +1079,12 @@ void CEGUIManipulator::onWidgetNameChanged()
 
 void CEGUIManipulator::onPropertyChanged(const QtnPropertyBase* property, CEGUI::Property* ceguiProperty)
 {
-    QString value;
-    if (property->toStr(value))
+    auto it = _propertyMap.find(property->name());
+    const auto writer = (it != _propertyMap.end()) ? it->second.accessors.writer : nullptr;
+
+    auto qtnProperty = qobject_cast<const QtnProperty*>(property);
+    if (qtnProperty && CEGUIPropertyBridge::write(writer, *qtnProperty, *ceguiProperty, *_widget))
     {
-        ceguiProperty->set(_widget, CEGUIUtils::qStringToString(value));
         updateFromWidget(false, true);
         update();
     }
@@ -1108,9 +1093,7 @@ void CEGUIManipulator::onPropertyChanged(const QtnPropertyBase* property, CEGUI:
 bool CEGUIManipulator::shouldBeSkipped() const
 {
     if (!_widget->isAutoWindow()) return false;
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    const bool hideDeadEndAutoWidgets = settings->getEntryValue("layout/visual/hide_deadend_autowidgets").toBool();
-    return hideDeadEndAutoWidgets && !hasNonAutoWidgetDescendants();
+    return hideDeadEndAutoWidgets.get() && !hasNonAutoWidgetDescendants();
 }
 
 static bool impl_hasNonAutoWidgetDescendants(CEGUI::Window* widget)
@@ -1166,9 +1149,20 @@ bool CEGUIManipulator::canAcceptChildren(size_t count, bool showErrorMessages) c
 
 QVariant CEGUIManipulator::itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant& value)
 {
-    if (change == ItemSelectedHasChanged)
+    switch (change)
     {
-        if (value.toBool()) moveToFront();
+        case ItemSelectedHasChanged:
+            if (value.toBool()) moveToFront();
+            break;
+        case ItemPositionHasChanged:
+        case ItemVisibleHasChanged:
+        case ItemParentHasChanged:
+        case ItemZValueHasChanged:
+        case ItemSceneChange:
+        case ItemSceneHasChanged:
+            invalidateOverlapClipping();
+            break;
+        default: break;
     }
 
     return ResizableRectItem::itemChange(change, value);
@@ -2,14 +2,19 @@
 #define CEGUIMANIPULATOR_H
 
 #include "src/ui/ResizableRectItem.h"
+#include "src/cegui/CEGUIPropertyBridge.h"
+#include "qpainterpath.h"
 #include <CEGUI/UVector.h>
 #include <CEGUI/USize.h>
 #include <CEGUI/Sizef.h>
 #include "src/QtStdHash.h"
 #include <unordered_map>
+#include <list>
 
 // This is a rectangle that is synchronised with given CEGUI widget,
-// it provides moving and resizing functionality
+// it provides moving and resizing functionality. Property sets are created on demand,
+// sets of widgets not selected recently are released. Overlap clipping paths are cached
+// until any manipulator changes its geometry, visibility or stacking order.
 
 namespace CEGUI
 {
@@ -31,6 +36,7 @@ public:
 
     bool isLayoutContainer() const;
     bool isInLayoutContainer() const;
+    CEGUIManipulator* getTopmostAncestorLC() const;
 
     virtual QSizeF getMinSize() const override;
     virtual QSizeF getMaxSize() const override;
@@ -80,7 +86,9 @@ public:
 
     void updatePropertiesFromWidget(const QStringList& propertyNames);
     void updateAllPropertiesFromWidget();
-    QtnPropertySet* getPropertySet() const { return _propertySet; }
+    QtnPropertySet* getPropertySet();
+    bool hasPropertySet() const { return _propertySet != nullptr; }
+    void releasePropertySet();
 
     bool isMoveStarted() const { return _moveStarted; }
     void resetMove() { _moveStarted = false; }
@@ -92,18 +100,36 @@ public:
 
 protected:
 
+    static void releaseUnusedPropertySets();
+
+    void invalidateOverlapClipping();
+
+    const QPainterPath& getOverlapClipPath();
+
     void createPropertySet();
     void adjustPositionDeltaOnResize(CEGUI::UVector2& deltaPos, const CEGUI::USize& deltaSize);
 
     virtual void onWidgetNameChanged();
 
+    virtual void notifyRectChanged() override;
     virtual QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
     virtual void onPropertyChanged(const QtnPropertyBase* property, CEGUI::Property* ceguiProperty);
     virtual void impl_paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr);
 
+    struct PropertyBinding
+    {
+        CEGUI::Property* ceguiProperty;
+        QtnProperty* property;
+        CEGUIPropertyBridge::Accessors accessors;
+    };
+
     CEGUI::Window* _widget = nullptr;
     QtnPropertySet* _propertySet = nullptr;
-    std::unordered_map<QString, std::pair<CEGUI::Property*, QtnProperty*>> _propertyMap;
+    std::unordered_map<QString, PropertyBinding> _propertyMap;
+    std::list<CEGUIManipulator*>::iterator _propertySetUseIt; // Valid while the set exists
+    QPainterPath _overlapClipPath;
+    QRectF _overlapArea; // Our scene area with children when the overlap clipping was last invalidated
+    bool _overlapClipValid = false;
 
     bool _resizeStarted = false;
     bool _moveStarted = false;
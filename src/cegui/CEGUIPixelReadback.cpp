@@ -0,0 +1,92 @@
+#include "src/cegui/CEGUIPixelReadback.h"
+#include "qopenglcontext.h"
+#include "qopenglfunctions.h"
+#include <qopenglfunctions_3_2_core.h>
+#include <cstring>
+
+CEGUIPixelReadback::~CEGUIPixelReadback()
+{
+    if (QOpenGLContext::currentContext()) destroy();
+}
+
+// Reads the whole currently bound framebuffer, which must be at least width x height
+bool CEGUIPixelReadback::start(int width, int height)
+{
+    destroy();
+
+    if (width <= 0 || height <= 0) return false;
+
+    if (!_buffer.create()) return false;
+
+    _width = width;
+    _height = height;
+
+    _buffer.bind();
+    _buffer.setUsagePattern(QOpenGLBuffer::StreamRead);
+    _buffer.allocate(width * height * 4);
+
+    // With a pixel pack buffer bound the last argument is an offset in it, the call returns immediately
+    auto gl = QOpenGLContext::currentContext()->functions();
+    gl->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    gl->glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    _buffer.release();
+
+    if (auto gl3 = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_2_Core>())
+        _fence = gl3->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Without a flush the GPU may not even start the transfer until somebody waits for it
+    gl->glFlush();
+
+    return true;
+}
+
+bool CEGUIPixelReadback::isReady()
+{
+    if (!_buffer.isCreated()) return false;
+    if (!_fence) return true;
+
+    auto gl3 = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_2_Core>();
+    if (!gl3) return true;
+
+    const GLenum status = gl3->glClientWaitSync(_fence, 0, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+// Blocks if the transfer is still in progress. Rows of the result are bottom-up as OpenGL stores
+// them, the caller mirrors the image, preferably not in the GUI thread. The buffer is released.
+QImage CEGUIPixelReadback::finish()
+{
+    if (!_buffer.isCreated()) return QImage();
+
+    QImage result;
+
+    _buffer.bind();
+    if (auto data = _buffer.map(QOpenGLBuffer::ReadOnly))
+    {
+        // CEGUI renders premultiplied colours into its render targets
+        result = QImage(_width, _height, QImage::Format_RGBA8888_Premultiplied);
+        if (!result.isNull())
+            std::memcpy(result.bits(), data, static_cast<size_t>(result.sizeInBytes()));
+        _buffer.unmap();
+    }
+    _buffer.release();
+
+    destroy();
+
+    return result;
+}
+
+void CEGUIPixelReadback::destroy()
+{
+    if (_fence)
+    {
+        if (auto gl3 = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_2_Core>())
+            gl3->glDeleteSync(_fence);
+        _fence = nullptr;
+    }
+
+    _buffer.destroy();
+    _width = 0;
+    _height = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef CEGUIPIXELREADBACK_H
+#define CEGUIPIXELREADBACK_H
+
+#include "qopenglbuffer.h"
+#include "qimage.h"
+
+// Reads pixels of a framebuffer into a pixel buffer object. The transfer runs on the GPU while
+// the caller goes on, the buffer is mapped only when the GPU has finished writing it. Readiness
+// is known from a fence which requires OpenGL 3.2, without it the result is assumed to be ready.
+// Must be used and destroyed with the same OpenGL context current.
+
+class CEGUIPixelReadback
+{
+public:
+
+    CEGUIPixelReadback() = default;
+    CEGUIPixelReadback(const CEGUIPixelReadback&) = delete;
+    ~CEGUIPixelReadback();
+
+    CEGUIPixelReadback& operator =(const CEGUIPixelReadback&) = delete;
+
+    bool start(int width, int height);
+    bool isStarted() const { return _buffer.isCreated(); }
+    bool isReady();
+    QImage finish();
+    void destroy();
+
+protected:
+
+    QOpenGLBuffer _buffer { QOpenGLBuffer::PixelPackBuffer };
+    GLsync _fence = nullptr;
+    int _width = 0;
+    int _height = 0;
+};
+
+#endif // CEGUIPIXELREADBACK_H
@@ -0,0 +1,97 @@
+#include "src/cegui/CEGUIProjectSyncJob.h"
+#include "src/cegui/CEGUIManager.h"
+#include "qtimer.h"
+#include "qelapsedtimer.h"
+#include <exception>
+
+// Steps are batched until this time is spent, then control returns to the event loop
+static const qint64 TIME_SLICE_MS = 20;
+
+CEGUIProjectSyncJob::CEGUIProjectSyncJob(FinishCallback onFinish, QObject* parent)
+    : QObject(parent)
+    , _onFinish(onFinish)
+{
+}
+
+void CEGUIProjectSyncJob::addStep(const QString& description, StepCallback callback)
+{
+    _steps.push_back({ description, callback });
+    ++_stepCount;
+}
+
+void CEGUIProjectSyncJob::start()
+{
+    if (_running) return;
+
+    _running = true;
+    emit progressChanged(0, _stepCount, _steps.empty() ? QString() : _steps.front().description);
+    QTimer::singleShot(0, this, &CEGUIProjectSyncJob::runSteps);
+}
+
+// Remaining steps are dropped, the finish callback is responsible for leaving CEGUI consistent
+void CEGUIProjectSyncJob::cancel()
+{
+    if (!_running) return;
+
+    _steps.clear();
+    finish(Result::Cancelled);
+}
+
+void CEGUIProjectSyncJob::runSteps()
+{
+    if (!_running) return;
+
+    auto& ceguiManager = CEGUIManager::Instance();
+    ceguiManager.makeOpenGLContextCurrent();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QString error;
+    while (!_steps.empty() && timer.elapsed() < TIME_SLICE_MS)
+    {
+        Step step = std::move(_steps.front());
+        _steps.pop_front();
+
+        try
+        {
+            step.callback();
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+            break;
+        }
+
+        ++_stepsDone;
+    }
+
+    ceguiManager.doneOpenGLContextCurrent();
+
+    if (!error.isEmpty())
+    {
+        _steps.clear();
+        finish(Result::Failed, error);
+    }
+    else if (_steps.empty())
+    {
+        finish(Result::Succeeded);
+    }
+    else
+    {
+        emit progressChanged(_stepsDone, _stepCount, _steps.front().description);
+        QTimer::singleShot(0, this, &CEGUIProjectSyncJob::runSteps);
+    }
+}
+
+void CEGUIProjectSyncJob::finish(Result result, const QString& error)
+{
+    _running = false;
+
+    if (result == Result::Failed) emit failed(error);
+
+    if (_onFinish) _onFinish(result, error);
+
+    emit progressChanged(_stepCount, _stepCount, QString());
+    emit finished(result == Result::Succeeded);
+}
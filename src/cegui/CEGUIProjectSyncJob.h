@@ -0,0 +1,66 @@
+#ifndef CEGUIPROJECTSYNCJOB_H
+#define CEGUIPROJECTSYNCJOB_H
+
+#include "qobject.h"
+#include "qstring.h"
+#include <deque>
+#include <functional>
+
+// Runs a project synchronisation as a queue of small steps, one resource each, executed on the
+// main thread between event loop iterations. CEGUI is not thread safe, so this is what keeps
+// the UI responsive. Can be cancelled between any two steps.
+
+class CEGUIProjectSyncJob : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    enum class Result
+    {
+        Succeeded,
+        Failed,
+        Cancelled
+    };
+
+    typedef std::function<void()> StepCallback;
+    typedef std::function<void(Result result, const QString& error)> FinishCallback;
+
+    explicit CEGUIProjectSyncJob(FinishCallback onFinish, QObject* parent = nullptr);
+
+    void addStep(const QString& description, StepCallback callback);
+    void start();
+    void cancel();
+
+    bool isRunning() const { return _running; }
+    int getStepCount() const { return _stepCount; }
+    int getStepsDone() const { return _stepsDone; }
+
+signals:
+
+    void progressChanged(int value, int maximum, const QString& description);
+    void finished(bool success);
+    void failed(const QString& error); // Before CEGUI resources are destroyed
+
+private slots:
+
+    void runSteps();
+
+private:
+
+    void finish(Result result, const QString& error = QString());
+
+    struct Step
+    {
+        QString description;
+        StepCallback callback;
+    };
+
+    std::deque<Step> _steps;
+    FinishCallback _onFinish;
+    int _stepCount = 0;
+    int _stepsDone = 0;
+    bool _running = false;
+};
+
+#endif // CEGUIPROJECTSYNCJOB_H
@@ -0,0 +1,100 @@
+#include "src/cegui/CEGUIPropertyBridge.h"
+#include "src/cegui/CEGUIUtils.h"
+#include "src/cegui/QtnPropertyUDim.h"
+#include "src/cegui/QtnPropertyUVector2.h"
+#include "src/cegui/QtnPropertyUVector3.h"
+#include "src/cegui/QtnPropertyUSize.h"
+#include "src/cegui/QtnPropertyURect.h"
+#include "src/cegui/QtnPropertyUBox.h"
+#include "QtnProperty/Core/PropertyBool.h"
+#include "QtnProperty/Core/PropertyUInt.h"
+#include "QtnProperty/Core/PropertyFloat.h"
+#include "QtnProperty/Core/PropertyEnum.h"
+#include <CEGUI/CEGUI.h>
+#include <CEGUI/TypedProperty.h>
+
+namespace CEGUIPropertyBridge
+{
+
+// The CEGUI property type is checked once in findAccessors, the Qtn one may differ when
+// the data type was overridden through a property map, then the string path is taken
+template<typename T, typename TQtnBase>
+static bool readTyped(const CEGUI::Property& ceguiProperty, const CEGUI::Window& widget, QtnProperty& property)
+{
+    auto qtnProperty = qobject_cast<TQtnBase*>(&property);
+    if (!qtnProperty) return false;
+
+    const auto& typedProperty = static_cast<const CEGUI::TypedProperty<T>&>(ceguiProperty);
+    return qtnProperty->setValue(static_cast<typename TQtnBase::ValueType>(typedProperty.getNative(&widget)),
+                                 QtnPropertyChangeReasonNewValue);
+}
+
+template<typename T, typename TQtnBase>
+static bool writeTyped(const QtnProperty& property, CEGUI::Property& ceguiProperty, CEGUI::Window& widget)
+{
+    auto qtnProperty = qobject_cast<const TQtnBase*>(&property);
+    if (!qtnProperty) return false;
+
+    auto& typedProperty = static_cast<CEGUI::TypedProperty<T>&>(ceguiProperty);
+    typedProperty.setNative(&widget, static_cast<T>(qtnProperty->value()));
+    return true;
+}
+
+template<typename T, typename TQtnBase>
+static bool tryAccessors(const CEGUI::Property& ceguiProperty, Accessors& accessors)
+{
+    if (!dynamic_cast<const CEGUI::TypedProperty<T>*>(&ceguiProperty)) return false;
+
+    accessors.reader = &readTyped<T, TQtnBase>;
+    accessors.writer = &writeTyped<T, TQtnBase>;
+    return true;
+}
+
+Accessors findAccessors(const CEGUI::Property& ceguiProperty)
+{
+    Accessors accessors;
+
+    // The most frequently synchronized ones first, positions and sizes change on every move
+    tryAccessors<CEGUI::UVector2, QtnPropertyUVector2Base>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::USize, QtnPropertyUSizeBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::URect, QtnPropertyURectBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::UDim, QtnPropertyUDimBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::UBox, QtnPropertyUBoxBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::UVector3, QtnPropertyUVector3Base>(ceguiProperty, accessors) ||
+    tryAccessors<float, QtnPropertyFloatBase>(ceguiProperty, accessors) ||
+    tryAccessors<bool, QtnPropertyBoolBase>(ceguiProperty, accessors) ||
+    tryAccessors<std::uint32_t, QtnPropertyUIntBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::HorizontalAlignment, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::VerticalAlignment, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::AspectMode, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::DefaultParagraphDirection, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::WindowUpdateMode, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::HorizontalFormatting, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::VerticalFormatting, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::HorizontalTextFormatting, QtnPropertyEnumBase>(ceguiProperty, accessors) ||
+    tryAccessors<CEGUI::VerticalTextFormatting, QtnPropertyEnumBase>(ceguiProperty, accessors);
+
+    return accessors;
+}
+
+void read(Reader reader, const CEGUI::Property& ceguiProperty, const CEGUI::Window& widget, QtnProperty& property)
+{
+    // Would be rejected anyway, don't waste time on getting the value
+    if (!property.isWritable()) return;
+
+    if (reader && reader(ceguiProperty, widget, property)) return;
+    property.fromStr(CEGUIUtils::stringToQString(ceguiProperty.get(&widget)));
+}
+
+bool write(Writer writer, const QtnProperty& property, CEGUI::Property& ceguiProperty, CEGUI::Window& widget)
+{
+    if (writer && writer(property, ceguiProperty, widget)) return true;
+
+    QString value;
+    if (!property.toStr(value)) return false;
+
+    ceguiProperty.set(&widget, CEGUIUtils::qStringToString(value));
+    return true;
+}
+
+}
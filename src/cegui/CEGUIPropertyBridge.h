@@ -0,0 +1,33 @@
+#ifndef CEGUIPROPERTYBRIDGE_H
+#define CEGUIPROPERTYBRIDGE_H
+
+// Transfers values between CEGUI properties and Qtn properties of matching types natively,
+// without formatting them to strings and parsing back. Accessors are resolved once per CEGUI
+// property, properties of types not bridged here are transferred through strings.
+
+namespace CEGUI
+{
+    class Window;
+    class Property;
+}
+
+class QtnProperty;
+
+namespace CEGUIPropertyBridge
+{
+    typedef bool (*Reader)(const CEGUI::Property& ceguiProperty, const CEGUI::Window& widget, QtnProperty& property);
+    typedef bool (*Writer)(const QtnProperty& property, CEGUI::Property& ceguiProperty, CEGUI::Window& widget);
+
+    struct Accessors
+    {
+        Reader reader = nullptr;
+        Writer writer = nullptr;
+    };
+
+    Accessors findAccessors(const CEGUI::Property& ceguiProperty);
+
+    void read(Reader reader, const CEGUI::Property& ceguiProperty, const CEGUI::Window& widget, QtnProperty& property);
+    bool write(Writer writer, const QtnProperty& property, CEGUI::Property& ceguiProperty, CEGUI::Window& widget);
+};
+
+#endif // CEGUIPROPERTYBRIDGE_H
@@ -0,0 +1,142 @@
+#include "src/cegui/CEGUIPropertySchema.h"
+#include "src/cegui/CEGUIManager.h"
+#include "src/cegui/CEGUIUtils.h"
+#include "qstringlist.h"
+#include <CEGUI/Window.h>
+#include <CEGUI/PropertyHelper.h>
+#include <map>
+
+// Properties of a widget depend on its class, on the look which adds property definitions
+// and on the window renderer, the type defines all of them unless they are changed explicitly
+QString CEGUIPropertySchema::getKey(const CEGUI::Window& widget)
+{
+    return CEGUIUtils::stringToQString(widget.getType()) + '|' +
+            CEGUIUtils::stringToQString(widget.getLookNFeel()) + '|' +
+            CEGUIUtils::stringToQString(widget.getWindowRendererName());
+}
+
+void CEGUIPropertySchema::build(const CEGUI::Window& widget)
+{
+    categories.clear();
+    categories.emplace_back(); // Top level
+
+    auto& mgr = CEGUIManager::Instance();
+
+    std::map<QString, Category> subsets;
+    auto it = widget.getPropertyIterator();
+    while (!it.isAtEnd())
+    {
+        CEGUI::Property* ceguiProp = it.getCurrentValue();
+        ++it;
+
+        if (!ceguiProp->isReadable()) continue;
+
+        // Categorize properties by CEGUI property origin
+        Category* category = &categories.front();
+        QString categoryName = CEGUIUtils::stringToQString(ceguiProp->getOrigin());
+        if (categoryName.startsWith("CEGUI/")) categoryName = categoryName.mid(6);
+        if (!categoryName.isEmpty())
+        {
+            category = &subsets[categoryName];
+            category->name = categoryName;
+        }
+
+        Property prop;
+        prop.ceguiProperty = ceguiProp;
+        prop.name = CEGUIUtils::stringToQString(ceguiProp->getName());
+        prop.help = CEGUIUtils::stringToQString(ceguiProp->getHelp());
+        prop.writable = ceguiProp->isWritable();
+
+        const auto& propertyDataType = ceguiProp->getDataType(); // could be overridden through a property map
+        if (propertyDataType == "bool")
+            prop.kind = Kind::Bool;
+        else if (propertyDataType == "std::uint32_t")
+        {
+            prop.kind = Kind::UInt;
+            prop.defaultValue = CEGUI::PropertyHelper<std::uint32_t>().fromString(ceguiProp->getDefault(&widget));
+        }
+        else if (propertyDataType == "float")
+        {
+            prop.kind = Kind::Float;
+            prop.defaultValue = CEGUI::PropertyHelper<float>().fromString(ceguiProp->getDefault(&widget));
+        }
+        else if (propertyDataType == "HorizontalAlignment")
+            prop.enumInfo = &mgr.enumHorizontalAlignment();
+        else if (propertyDataType == "VerticalAlignment")
+            prop.enumInfo = &mgr.enumVerticalAlignment();
+        else if (propertyDataType == "AspectMode")
+            prop.enumInfo = &mgr.enumAspectMode();
+        else if (propertyDataType == "DefaultParagraphDirection")
+            prop.enumInfo = &mgr.enumDefaultParagraphDirection();
+        else if (propertyDataType == "WindowUpdateMode")
+            prop.enumInfo = &mgr.enumWindowUpdateMode();
+        else if (propertyDataType == "VerticalFormatting")
+            prop.enumInfo = &mgr.enumVerticalFormatting();
+        else if (propertyDataType == "HorizontalFormatting")
+            prop.enumInfo = &mgr.enumHorizontalFormatting();
+        else if (propertyDataType == "VerticalTextFormatting")
+            prop.enumInfo = &mgr.enumVerticalTextFormatting();
+        else if (propertyDataType == "HorizontalTextFormatting")
+            prop.enumInfo = &mgr.enumHorizontalTextFormatting();
+        else if (propertyDataType == "Font")
+            prop.kind = Kind::Font;
+        else if (propertyDataType == "Image")
+            prop.kind = Kind::Image;
+        else if (propertyDataType == "UDim")
+            prop.kind = Kind::UDim;
+        else if (propertyDataType == "UVector2")
+            prop.kind = Kind::UVector2;
+        else if (propertyDataType == "UVector3")
+            prop.kind = Kind::UVector3;
+        else if (propertyDataType == "USize")
+            prop.kind = Kind::USize;
+        else if (propertyDataType == "URect")
+            prop.kind = Kind::URect;
+        else if (propertyDataType == "UBox")
+            prop.kind = Kind::UBox;
+        else
+        {
+            // TODO: implement vec2, Rectf, quat, ColourRect (4x colour subproperty and a preview),
+            // NumOfTextLinesToShow, SortMode, Colour. They are edited as strings for now.
+            static const QStringList knownStringTypes = { "String", "vec2", "Rectf", "quat", "ColourRect", "NumOfTextLinesToShow" };
+            if (!knownStringTypes.contains(CEGUIUtils::stringToQString(propertyDataType)))
+            {
+                assert(false && "propertyDataType unknown");
+            }
+            prop.kind = Kind::String;
+        }
+
+        if (prop.enumInfo) prop.kind = Kind::Enum;
+
+        prop.accessors = CEGUIPropertyBridge::findAccessors(*ceguiProp);
+
+        category->properties.push_back(std::move(prop));
+    }
+
+    // We want to see some categories at the beginning of the list
+    const QStringList fixedOrderFirst = { "Element", "NamedElement", "Window" };
+    for (const QString& name : fixedOrderFirst)
+    {
+        auto itSet = subsets.find(name);
+        if (itSet != subsets.end())
+        {
+            categories.push_back(std::move(itSet->second));
+            subsets.erase(itSet);
+        }
+    }
+
+    // Unknown is always the last
+    auto itUnknown = subsets.find("Unknown");
+    Category unknown;
+    const bool hasUnknown = (itUnknown != subsets.end());
+    if (hasUnknown)
+    {
+        unknown = std::move(itUnknown->second);
+        subsets.erase(itUnknown);
+    }
+
+    for (auto& pair : subsets)
+        categories.push_back(std::move(pair.second));
+
+    if (hasUnknown) categories.push_back(std::move(unknown));
+}
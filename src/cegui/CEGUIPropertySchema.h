@@ -0,0 +1,66 @@
+#ifndef CEGUIPROPERTYSCHEMA_H
+#define CEGUIPROPERTYSCHEMA_H
+
+#include "qstring.h"
+#include "qvariant.h"
+#include "src/cegui/CEGUIPropertyBridge.h"
+#include <vector>
+
+// What a property editor of a CEGUI widget consists of, the same for all widgets of one type, look
+// and window renderer. Readable properties are grouped by their origin into categories which are
+// ordered as they are shown. Property kinds, defaults and native value accessors are resolved once.
+// CEGUIManager caches schemas until resources are reloaded, property sets are built from them.
+
+namespace CEGUI
+{
+    class Window;
+    class Property;
+}
+
+class QtnEnumInfo;
+
+struct CEGUIPropertySchema
+{
+    enum class Kind
+    {
+        Bool,
+        UInt,
+        Float,
+        Enum,
+        UDim,
+        Font,
+        Image,
+        UVector2,
+        UVector3,
+        USize,
+        URect,
+        UBox,
+        String
+    };
+
+    struct Property
+    {
+        CEGUI::Property* ceguiProperty = nullptr; // Owned by the window class or by the look
+        QString name;
+        QString help;
+        Kind kind = Kind::String;
+        const QtnEnumInfo* enumInfo = nullptr;
+        QVariant defaultValue; // For UInt and Float only
+        CEGUIPropertyBridge::Accessors accessors; // Empty when values go through strings
+        bool writable = true;
+    };
+
+    struct Category
+    {
+        QString name; // Empty for properties shown at the top level
+        std::vector<Property> properties;
+    };
+
+    static QString getKey(const CEGUI::Window& widget);
+
+    void build(const CEGUI::Window& widget);
+
+    std::vector<Category> categories;
+};
+
+#endif // CEGUIPROPERTYSCHEMA_H
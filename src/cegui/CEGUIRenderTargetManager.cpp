@@ -0,0 +1,66 @@
+#include "src/cegui/CEGUIRenderTargetManager.h"
+#include "src/ui/CEGUIGraphicsScene.h"
+#include "src/util/SettingsHandle.h"
+#include "qgraphicsview.h"
+#include <algorithm>
+
+static SettingsHandle<int> offscreenBudget("cegui/rendering/offscreen_budget");
+
+// Must be called with the CEGUI OpenGL context current, evicted buffers are deleted right away
+void CEGUIRenderTargetManager::onBufferRendered(CEGUIGraphicsScene* scene, qint64 bytes)
+{
+    auto it = std::find_if(_buffers.begin(), _buffers.end(), [scene](const Buffer& buffer) { return buffer.scene == scene; });
+    if (it != _buffers.end())
+    {
+        _usedBytes -= it->bytes;
+        _buffers.erase(it);
+    }
+
+    _buffers.push_back({ scene, bytes });
+    _usedBytes += bytes;
+
+    enforceBudget(scene);
+}
+
+void CEGUIRenderTargetManager::onBufferReleased(CEGUIGraphicsScene* scene)
+{
+    auto it = std::find_if(_buffers.begin(), _buffers.end(), [scene](const Buffer& buffer) { return buffer.scene == scene; });
+    if (it == _buffers.end()) return;
+
+    _usedBytes -= it->bytes;
+    _buffers.erase(it);
+}
+
+// In bytes, 0 means no limit
+qint64 CEGUIRenderTargetManager::getBudget() const
+{
+    return std::max(0, offscreenBudget.get()) * 1024LL * 1024LL;
+}
+
+// Buffers being shown are never evicted, so the budget may be exceeded by visible scenes alone
+void CEGUIRenderTargetManager::enforceBudget(const CEGUIGraphicsScene* current)
+{
+    const qint64 budget = getBudget();
+    if (!budget) return;
+
+    for (size_t i = 0; i < _buffers.size() && _usedBytes > budget; )
+    {
+        CEGUIGraphicsScene* scene = _buffers[i].scene;
+        if (scene == current || isSceneShown(scene))
+        {
+            ++i;
+            continue;
+        }
+
+        _usedBytes -= _buffers[i].bytes;
+        _buffers.erase(_buffers.begin() + static_cast<std::ptrdiff_t>(i));
+        scene->releaseOffscreenBuffer();
+    }
+}
+
+bool CEGUIRenderTargetManager::isSceneShown(const CEGUIGraphicsScene* scene)
+{
+    for (auto view : scene->views())
+        if (view->isVisible()) return true;
+    return false;
+}
@@ -0,0 +1,39 @@
+#ifndef CEGUIRENDERTARGETMANAGER_H
+#define CEGUIRENDERTARGETMANAGER_H
+
+#include "qglobal.h"
+#include <vector>
+
+// Keeps offscreen buffers of all CEGUI scenes within a GPU memory budget. Scenes report their buffer
+// after each render, buffers of scenes not shown in any view are released starting from the least
+// recently rendered one. A scene without a buffer is rendered into a new one when shown again.
+
+class CEGUIGraphicsScene;
+
+class CEGUIRenderTargetManager
+{
+public:
+
+    void onBufferRendered(CEGUIGraphicsScene* scene, qint64 bytes);
+    void onBufferReleased(CEGUIGraphicsScene* scene);
+
+    size_t getBufferCount() const { return _buffers.size(); }
+    qint64 getUsedBytes() const { return _usedBytes; }
+    qint64 getBudget() const;
+
+protected:
+
+    void enforceBudget(const CEGUIGraphicsScene* current);
+    static bool isSceneShown(const CEGUIGraphicsScene* scene);
+
+    struct Buffer
+    {
+        CEGUIGraphicsScene* scene;
+        qint64 bytes;
+    };
+
+    std::vector<Buffer> _buffers; // From the least to the most recently rendered
+    qint64 _usedBytes = 0;
+};
+
+#endif // CEGUIRENDERTARGETMANAGER_H
@@ -0,0 +1,316 @@
+#include "src/cegui/CEGUIResourceCache.h"
+#include "qstandardpaths.h"
+#include "qcryptographichash.h"
+#include "qfileinfo.h"
+#include "qdatetime.h"
+#include "qdatastream.h"
+#include "qsavefile.h"
+#include "qdir.h"
+#include "qset.h"
+
+static const quint32 CACHE_INDEX_MAGIC = 0x43454544; // 'CEED'
+static const quint32 CACHE_TEXTURE_MAGIC = 0x54455854; // 'TEXT'
+static const quint32 CACHE_VERSION = 1;
+
+CEGUIResourceCache::~CEGUIResourceCache()
+{
+    close();
+}
+
+// Each project gets its own directory named after the hash of the project file path
+void CEGUIResourceCache::open(const QString& projectFilePath)
+{
+    const QString projectHash = QCryptographicHash::hash(QFileInfo(projectFilePath).absoluteFilePath().toUtf8(),
+                                                         QCryptographicHash::Sha1).toHex();
+    const QString cacheDir = QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("projects/" + projectHash);
+
+    if (cacheDir == _cacheDir) return;
+
+    detach();
+
+    if (!QDir().mkpath(QDir(cacheDir).filePath("textures"))) return;
+
+    QMutexLocker lock(&_mutex);
+
+    _cacheDir = cacheDir;
+
+    QFile file(QDir(_cacheDir).filePath("index.dat"));
+    if (!file.open(QFile::ReadOnly)) return;
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if (magic != CACHE_INDEX_MAGIC || version != CACHE_VERSION) return;
+
+    qint32 count = 0;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString filePath;
+        ResourceFingerprint fingerprint;
+        stream >> filePath >> fingerprint.size >> fingerprint.lastModified >> fingerprint.hash;
+        _fingerprints.insert(filePath, fingerprint);
+    }
+
+    stream >> _descriptors;
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        // Corrupted index, start from scratch
+        _fingerprints.clear();
+        _descriptors.clear();
+    }
+}
+
+void CEGUIResourceCache::close()
+{
+    detach();
+
+    QMutexLocker lock(&_mutex);
+    _fingerprints.clear();
+    _descriptors.clear();
+}
+
+// Stops persisting, hashes and descriptors read so far are still served from memory
+void CEGUIResourceCache::detach()
+{
+    save();
+
+    QMutexLocker lock(&_mutex);
+    _cacheDir.clear();
+    _thumbnailState.clear();
+    _modified = false;
+}
+
+void CEGUIResourceCache::save()
+{
+    QMutexLocker lock(&_mutex);
+
+    if (_cacheDir.isEmpty() || !_modified) return;
+
+    prune();
+
+    QSaveFile file(QDir(_cacheDir).filePath("index.dat"));
+    if (!file.open(QFile::WriteOnly)) return;
+
+    QDataStream stream(&file);
+    stream << CACHE_INDEX_MAGIC << CACHE_VERSION;
+
+    stream << static_cast<qint32>(_fingerprints.size());
+    for (auto it = _fingerprints.cbegin(); it != _fingerprints.cend(); ++it)
+        stream << it.key() << it.value().size << it.value().lastModified << it.value().hash;
+
+    stream << _descriptors;
+
+    if (file.commit())
+        _modified = false;
+}
+
+// Forgets files that no longer exist and drops data no remembered file content refers to
+void CEGUIResourceCache::prune()
+{
+    QSet<QString> usedHashes;
+    for (auto it = _fingerprints.begin(); it != _fingerprints.end(); )
+    {
+        if (QFileInfo::exists(it.key()))
+        {
+            usedHashes.insert(it.value().hash.toHex());
+            ++it;
+        }
+        else
+        {
+            it = _fingerprints.erase(it);
+        }
+    }
+
+    for (auto it = _descriptors.begin(); it != _descriptors.end(); )
+    {
+        if (usedHashes.contains(it.key().section('|', 0, 0)))
+            ++it;
+        else
+            it = _descriptors.erase(it);
+    }
+
+    QDir texturesDir(QDir(_cacheDir).filePath("textures"));
+    for (const auto& fileName : texturesDir.entryList(QDir::Files))
+        if (!usedHashes.contains(QFileInfo(fileName).baseName()))
+            texturesDir.remove(fileName);
+
+    // Thumbnails depend on all resources at once, only the current set is worth keeping
+    if (!_thumbnailState.isEmpty())
+    {
+        QDir thumbnailsDir(QDir(_cacheDir).filePath("thumbnails"));
+        for (const auto& dirName : thumbnailsDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+            if (dirName != _thumbnailState)
+                QDir(thumbnailsDir.filePath(dirName)).removeRecursively();
+    }
+}
+
+// Content hash is recomputed only if the file size or modification time differs from the remembered one
+ResourceFingerprint CEGUIResourceCache::getFingerprint(const QString& filePath)
+{
+    QFileInfo info(filePath);
+    if (!info.exists() || info.isDir()) return ResourceFingerprint();
+
+    const qint64 size = info.size();
+    const qint64 lastModified = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        QMutexLocker lock(&_mutex);
+        auto it = _fingerprints.find(filePath);
+        if (it != _fingerprints.end() && it.value().size == size && it.value().lastModified == lastModified)
+            return it.value();
+    }
+
+    ResourceFingerprint fingerprint;
+    fingerprint.size = size;
+    fingerprint.lastModified = lastModified;
+    fingerprint.hash = ResourceFingerprint::hashFile(filePath);
+
+    QMutexLocker lock(&_mutex);
+    _fingerprints.insert(filePath, fingerprint);
+    _modified = true;
+
+    return fingerprint;
+}
+
+std::vector<QXmlStreamAttributes> CEGUIResourceCache::readElementAttributes(const QString& filePath, const QString& elementName)
+{
+    const auto fingerprint = getFingerprint(filePath);
+    const QString key = fingerprint.hash.toHex() + '|' + elementName;
+
+    std::vector<QXmlStreamAttributes> result;
+
+    {
+        QMutexLocker lock(&_mutex);
+        auto it = _descriptors.find(key);
+        if (it != _descriptors.end())
+        {
+            for (const auto& cachedAttrs : it.value())
+            {
+                QXmlStreamAttributes attrs;
+                for (const auto& pair : cachedAttrs)
+                    attrs.append(pair.first, pair.second);
+                result.push_back(std::move(attrs));
+            }
+            return result;
+        }
+    }
+
+    result = CEGUIResourceTracker::readElementAttributes(filePath, elementName);
+
+    if (!fingerprint.isValid()) return result;
+
+    QVector<CachedAttributes> cachedElements;
+    for (const auto& attrs : result)
+    {
+        CachedAttributes cachedAttrs;
+        for (const auto& attr : attrs)
+            cachedAttrs.push_back({ attr.qualifiedName().toString(), attr.value().toString() });
+        cachedElements.push_back(std::move(cachedAttrs));
+    }
+
+    QMutexLocker lock(&_mutex);
+    _descriptors.insert(key, cachedElements);
+    _modified = true;
+
+    return result;
+}
+
+QString CEGUIResourceCache::getTextureBlobPath(const QByteArray& contentHash) const
+{
+    return QDir(_cacheDir).filePath("textures/" + QString(contentHash.toHex()) + ".rgba");
+}
+
+// Returns a null image if there is no cached texture for the current file content
+QImage CEGUIResourceCache::loadTexture(const QString& imageFilePath)
+{
+    const auto fingerprint = getFingerprint(imageFilePath);
+    if (!fingerprint.isValid()) return QImage();
+
+    QString blobPath;
+    {
+        QMutexLocker lock(&_mutex);
+        if (_cacheDir.isEmpty()) return QImage();
+        blobPath = getTextureBlobPath(fingerprint.hash);
+    }
+
+    QFile file(blobPath);
+    if (!file.open(QFile::ReadOnly)) return QImage();
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0;
+    qint32 width = 0, height = 0;
+    stream >> magic >> version >> width >> height;
+    if (magic != CACHE_TEXTURE_MAGIC || version != CACHE_VERSION || width <= 0 || height <= 0) return QImage();
+
+    // Raw pixels are read right into the image memory, RGBA8888 rows are always tightly packed
+    QImage image(width, height, QImage::Format_RGBA8888);
+    const int dataSize = static_cast<int>(image.sizeInBytes());
+    if (stream.readRawData(reinterpret_cast<char*>(image.bits()), dataSize) != dataSize) return QImage();
+
+    return image;
+}
+
+void CEGUIResourceCache::storeTexture(const QString& imageFilePath, const QImage& image)
+{
+    if (image.isNull() || image.format() != QImage::Format_RGBA8888) return;
+
+    const auto fingerprint = getFingerprint(imageFilePath);
+    if (!fingerprint.isValid()) return;
+
+    QString blobPath;
+    {
+        QMutexLocker lock(&_mutex);
+        if (_cacheDir.isEmpty()) return;
+        blobPath = getTextureBlobPath(fingerprint.hash);
+    }
+
+    QSaveFile file(blobPath);
+    if (!file.open(QFile::WriteOnly)) return;
+
+    QDataStream stream(&file);
+    stream << CACHE_TEXTURE_MAGIC << CACHE_VERSION << static_cast<qint32>(image.width()) << static_cast<qint32>(image.height());
+    stream.writeRawData(reinterpret_cast<const char*>(image.constBits()), static_cast<int>(image.sizeInBytes()));
+    file.commit();
+}
+
+QString CEGUIResourceCache::getThumbnailPath(const QByteArray& resourceStateHash, const QString& name) const
+{
+    const QByteArray nameHash = QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Sha1);
+    return QDir(_cacheDir).filePath("thumbnails/" + QString(resourceStateHash.toHex()) + "/" + QString(nameHash.toHex()) + ".png");
+}
+
+// Returns a null image if there is no thumbnail rendered with the same resources
+QImage CEGUIResourceCache::loadThumbnail(const QByteArray& resourceStateHash, const QString& name)
+{
+    QString thumbnailPath;
+    {
+        QMutexLocker lock(&_mutex);
+        if (_cacheDir.isEmpty()) return QImage();
+        _thumbnailState = resourceStateHash.toHex();
+        thumbnailPath = getThumbnailPath(resourceStateHash, name);
+    }
+
+    return QImage(thumbnailPath);
+}
+
+void CEGUIResourceCache::storeThumbnail(const QByteArray& resourceStateHash, const QString& name, const QImage& image)
+{
+    if (image.isNull()) return;
+
+    QString thumbnailPath;
+    {
+        QMutexLocker lock(&_mutex);
+        if (_cacheDir.isEmpty()) return;
+        _thumbnailState = resourceStateHash.toHex();
+        _modified = true;
+        thumbnailPath = getThumbnailPath(resourceStateHash, name);
+    }
+
+    if (!QDir().mkpath(QFileInfo(thumbnailPath).path())) return;
+
+    QSaveFile file(thumbnailPath);
+    if (file.open(QFile::WriteOnly) && image.save(&file, "PNG"))
+        file.commit();
+}
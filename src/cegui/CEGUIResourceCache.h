@@ -0,0 +1,51 @@
+#ifndef CEGUIRESOURCECACHE_H
+#define CEGUIRESOURCECACHE_H
+
+#include "src/cegui/CEGUIResourceTracker.h"
+#include "qmutex.h"
+#include "qimage.h"
+#include "qhash.h"
+#include <vector>
+
+// Per-project on-disk cache of data derived from resource files: content hashes, descriptor
+// elements we read from XML, decoded texture pixels and widget thumbnails. Everything except hashes
+// is keyed by file content, so a stale entry can't be picked up for a changed file. When the cache is not
+// opened, hashes and descriptors are kept in memory only and textures and thumbnails are not cached at all.
+// Thread safe, used by texture decoders.
+
+class CEGUIResourceCache
+{
+public:
+
+    ~CEGUIResourceCache();
+
+    void open(const QString& projectFilePath);
+    void close();
+    void detach();
+    void save();
+    bool isOpened() const { return !_cacheDir.isEmpty(); }
+
+    ResourceFingerprint getFingerprint(const QString& filePath);
+    std::vector<QXmlStreamAttributes> readElementAttributes(const QString& filePath, const QString& elementName);
+    QImage loadTexture(const QString& imageFilePath);
+    void storeTexture(const QString& imageFilePath, const QImage& image);
+    QImage loadThumbnail(const QByteArray& resourceStateHash, const QString& name);
+    void storeThumbnail(const QByteArray& resourceStateHash, const QString& name, const QImage& image);
+
+protected:
+
+    typedef QVector<QPair<QString, QString>> CachedAttributes;
+
+    QString getTextureBlobPath(const QByteArray& contentHash) const;
+    QString getThumbnailPath(const QByteArray& resourceStateHash, const QString& name) const;
+    void prune();
+
+    QMutex _mutex;
+    QString _cacheDir;
+    QHash<QString, ResourceFingerprint> _fingerprints; // By absolute file path
+    QHash<QString, QVector<CachedAttributes>> _descriptors; // By content hash and element name
+    QString _thumbnailState; // Hex hash of resources thumbnails were last used with, others are pruned
+    bool _modified = false;
+};
+
+#endif // CEGUIRESOURCECACHE_H
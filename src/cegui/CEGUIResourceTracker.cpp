@@ -0,0 +1,247 @@
+#include "src/cegui/CEGUIResourceTracker.h"
+#include "src/cegui/CEGUIProject.h"
+#include "src/cegui/CEGUIResourceCache.h"
+#include "qfileinfo.h"
+#include "qdatetime.h"
+#include "qcryptographichash.h"
+#include <algorithm>
+
+ResourceFingerprint ResourceFingerprint::fromFile(const QString& filePath)
+{
+    ResourceFingerprint fingerprint;
+
+    QFileInfo info(filePath);
+    if (!info.exists() || info.isDir()) return fingerprint;
+
+    fingerprint.size = info.size();
+    fingerprint.lastModified = info.lastModified().toMSecsSinceEpoch();
+    fingerprint.hash = hashFile(filePath);
+    return fingerprint;
+}
+
+QByteArray ResourceFingerprint::hashFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly)) return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result();
+}
+
+bool ResourceFingerprint::isUpToDate(const QString& filePath)
+{
+    QFileInfo info(filePath);
+    if (!info.exists() || info.isDir()) return !isValid();
+
+    if (info.size() != size) return false;
+
+    const qint64 currModified = info.lastModified().toMSecsSinceEpoch();
+    if (currModified == lastModified) return true;
+
+    // Timestamp changed but size didn't, compare the content before deciding
+    if (hashFile(filePath) != hash) return false;
+
+    lastModified = currModified;
+    return true;
+}
+
+bool TrackedResource::isUpToDate()
+{
+    for (auto& pair : files)
+        if (!pair.second.isUpToDate(pair.first))
+            return false;
+
+    return true;
+}
+
+// Collects attributes of all elements with a given name, or of all elements if the name is empty.
+// CEGUI descriptors are small and flat enough to be read in one pass without building a DOM.
+std::vector<QXmlStreamAttributes> CEGUIResourceTracker::readElementAttributes(const QString& filePath, const QString& elementName)
+{
+    std::vector<QXmlStreamAttributes> result;
+
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly)) return result;
+
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd())
+    {
+        if (xml.readNext() == QXmlStreamReader::StartElement && (elementName.isEmpty() || xml.name() == elementName))
+            result.push_back(xml.attributes());
+    }
+
+    return result;
+}
+
+void CEGUIResourceTracker::clear()
+{
+    _schemes.clear();
+    _resourceDirs.clear();
+    clearDeferredResources();
+}
+
+TrackedResource CEGUIResourceTracker::trackResource(const CEGUIProject& project, ResourceType type,
+                                                    const QString& fileName, const QString& resourceGroup) const
+{
+    TrackedResource resource;
+    resource.fileName = fileName;
+    resource.resourceGroup = resourceGroup;
+
+    auto getFingerprint = [this](const QString& filePath)
+    {
+        return _cache ? _cache->getFingerprint(filePath) : ResourceFingerprint::fromFile(filePath);
+    };
+
+    auto getElements = [this](const QString& filePath, const QString& elementName)
+    {
+        return _cache ? _cache->readElementAttributes(filePath, elementName) : readElementAttributes(filePath, elementName);
+    };
+
+    const QString filePath = project.getResourceFilePath(fileName, resourceGroup);
+    resource.files.emplace_back(filePath, getFingerprint(filePath));
+
+    auto addReferencedFile = [&project, &resource, &getFingerprint](const QXmlStreamAttributes& attrs, const QString& fileAttr, const QString& defaultGroup)
+    {
+        const QString referencedFileName = attrs.value(fileAttr).toString();
+        if (referencedFileName.isEmpty()) return;
+
+        QString group = attrs.value("resourceGroup").toString();
+        if (group.isEmpty()) group = defaultGroup;
+
+        const QString referencedFilePath = project.getResourceFilePath(referencedFileName, group);
+        if (referencedFilePath.isEmpty()) return;
+
+        resource.files.emplace_back(referencedFilePath, getFingerprint(referencedFilePath));
+    };
+
+    switch (type)
+    {
+        case ResourceType::Scheme:
+        {
+            for (const auto& attrs : getElements(filePath, "GUIScheme"))
+                resource.objectNames.append(attrs.value("name").toString());
+            for (const auto& attrs : getElements(filePath, "ImageFileImageset"))
+                addReferencedFile(attrs, "filename", "imagesets");
+            break;
+        }
+        case ResourceType::Imageset:
+        {
+            for (const auto& attrs : getElements(filePath, "Imageset"))
+            {
+                resource.objectNames.append(attrs.value("name").toString());
+                addReferencedFile(attrs, "imagefile", "imagesets");
+            }
+            break;
+        }
+        case ResourceType::Font:
+        {
+            for (const auto& attrs : getElements(filePath, "Font"))
+            {
+                resource.objectNames.append(attrs.value("name").toString());
+                addReferencedFile(attrs, "filename", "fonts");
+            }
+            break;
+        }
+        case ResourceType::LookNFeel:
+        {
+            for (const auto& attrs : getElements(filePath, "WidgetLook"))
+                resource.objectNames.append(attrs.value("name").toString());
+            break;
+        }
+    }
+
+    resource.objectNames.removeAll(QString());
+
+    return resource;
+}
+
+TrackedScheme* CEGUIResourceTracker::findScheme(const QString& fileName)
+{
+    auto it = std::find_if(_schemes.begin(), _schemes.end(), [&fileName](const TrackedScheme& scheme)
+    {
+        return scheme.fileName == fileName;
+    });
+
+    return (it == _schemes.end()) ? nullptr : &(*it);
+}
+
+void CEGUIResourceTracker::removeScheme(const QString& fileName)
+{
+    _schemes.erase(std::remove_if(_schemes.begin(), _schemes.end(), [&fileName](const TrackedScheme& scheme)
+    {
+        return scheme.fileName == fileName;
+    }), _schemes.end());
+}
+
+const TrackedResource* CEGUIResourceTracker::findResource(ResourceType type, const QString& fileName) const
+{
+    for (const auto& scheme : _schemes)
+    {
+        if (type == ResourceType::Scheme)
+        {
+            if (scheme.fileName == fileName) return &scheme.schemeFiles;
+            continue;
+        }
+
+        const auto& resources = (type == ResourceType::Imageset) ? scheme.imagesets :
+                                (type == ResourceType::Font) ? scheme.fonts : scheme.looknfeels;
+
+        auto it = std::find_if(resources.cbegin(), resources.cend(), [&fileName](const TrackedResource& resource)
+        {
+            return resource.fileName == fileName;
+        });
+
+        if (it != resources.cend()) return &(*it);
+    }
+
+    return nullptr;
+}
+
+QHash<QString, DeferredResource>& CEGUIResourceTracker::getDeferredResources(ResourceType type)
+{
+    return (type == ResourceType::Imageset) ? _deferredImagesets :
+           (type == ResourceType::Font) ? _deferredFonts : _deferredLookNFeels;
+}
+
+const QHash<QString, DeferredResource>& CEGUIResourceTracker::getDeferredResources(ResourceType type) const
+{
+    return (type == ResourceType::Imageset) ? _deferredImagesets :
+           (type == ResourceType::Font) ? _deferredFonts : _deferredLookNFeels;
+}
+
+// The first scheme to reference an object wins, same as CEGUI would do when loading everything
+void CEGUIResourceTracker::deferResource(ResourceType type, const QString& objectName, const DeferredResource& resource)
+{
+    if (type == ResourceType::Scheme || objectName.isEmpty()) return;
+
+    auto& resources = getDeferredResources(type);
+    if (!resources.contains(objectName))
+        resources.insert(objectName, resource);
+}
+
+const DeferredResource* CEGUIResourceTracker::findDeferredResource(ResourceType type, const QString& objectName) const
+{
+    if (type == ResourceType::Scheme) return nullptr;
+
+    const auto& resources = getDeferredResources(type);
+    auto it = resources.constFind(objectName);
+    return (it == resources.cend()) ? nullptr : &it.value();
+}
+
+QStringList CEGUIResourceTracker::getDeferredResourceNames(ResourceType type) const
+{
+    return (type == ResourceType::Scheme) ? QStringList() : getDeferredResources(type).keys();
+}
+
+bool CEGUIResourceTracker::hasDeferredResources() const
+{
+    return !_deferredImagesets.isEmpty() || !_deferredFonts.isEmpty() || !_deferredLookNFeels.isEmpty();
+}
+
+void CEGUIResourceTracker::clearDeferredResources()
+{
+    _deferredImagesets.clear();
+    _deferredFonts.clear();
+    _deferredLookNFeels.clear();
+}
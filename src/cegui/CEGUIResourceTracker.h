@@ -0,0 +1,115 @@
+#ifndef CEGUIRESOURCETRACKER_H
+#define CEGUIRESOURCETRACKER_H
+
+#include "qstring.h"
+#include "qstringlist.h"
+#include "qbytearray.h"
+#include "qxmlstream.h"
+#include "qhash.h"
+#include <vector>
+
+// Remembers which files on disk each loaded scheme was built from. Used by the incremental
+// project synchronisation to rebuild only CEGUI objects whose source files have changed.
+// With lazy loading also knows where to find resources which are not loaded yet.
+
+class CEGUIProject;
+class CEGUIResourceCache;
+
+// Size and timestamp are checked first, content hash is computed only when they differ,
+// so touching a file without changing it doesn't trigger a reload
+struct ResourceFingerprint
+{
+    qint64 size = -1;
+    qint64 lastModified = 0;
+    QByteArray hash;
+
+    static ResourceFingerprint fromFile(const QString& filePath);
+    static QByteArray hashFile(const QString& filePath);
+
+    bool isValid() const { return size >= 0; }
+    bool isUpToDate(const QString& filePath);
+};
+
+// A resource loaded from a scheme: a descriptor file and everything it references
+struct TrackedResource
+{
+    QString fileName;       // As referenced in the scheme, relative to the resource group
+    QString resourceGroup;
+    QStringList objectNames; // Imageset, font or widget look names this file defines
+    std::vector<std::pair<QString, ResourceFingerprint>> files; // Absolute path and fingerprint, descriptor goes first
+
+    bool isUpToDate();
+};
+
+struct TrackedScheme
+{
+    QString name;
+    QString fileName;
+    TrackedResource schemeFiles; // The scheme itself and its image file imagesets
+    std::vector<TrackedResource> imagesets;
+    std::vector<TrackedResource> fonts;
+    std::vector<TrackedResource> looknfeels;
+};
+
+// A resource a scheme references but which is not loaded until something needs it
+struct DeferredResource
+{
+    QString schemeFile;
+    QString fileName;
+    QString resourceGroup; // As written in the scheme, may be empty
+};
+
+class CEGUIResourceTracker
+{
+public:
+
+    enum class ResourceType
+    {
+        Scheme,
+        Imageset,
+        Font,
+        LookNFeel
+    };
+
+    static std::vector<QXmlStreamAttributes> readElementAttributes(const QString& filePath, const QString& elementName);
+
+    // Fingerprints and descriptors are taken from the cache when it is set
+    void setCache(CEGUIResourceCache* cache) { _cache = cache; }
+
+    void clear();
+
+    // Reads a descriptor file and remembers it along with files it references
+    TrackedResource trackResource(const CEGUIProject& project, ResourceType type, const QString& fileName, const QString& resourceGroup) const;
+
+    std::vector<TrackedScheme>& getSchemes() { return _schemes; }
+    TrackedScheme* findScheme(const QString& fileName);
+    void removeScheme(const QString& fileName);
+
+    // Loaded resource with the given descriptor file, from any scheme
+    const TrackedResource* findResource(ResourceType type, const QString& fileName) const;
+
+    // Resources known by object name, for loading on demand
+    void deferResource(ResourceType type, const QString& objectName, const DeferredResource& resource);
+    const DeferredResource* findDeferredResource(ResourceType type, const QString& objectName) const;
+    QStringList getDeferredResourceNames(ResourceType type) const;
+    bool hasDeferredResources() const;
+    void clearDeferredResources();
+
+    // Resource directories the tracked state was built for, a change requires a full resync
+    void setResourceDirectories(const QStringList& dirs) { _resourceDirs = dirs; }
+    const QStringList& getResourceDirectories() const { return _resourceDirs; }
+
+protected:
+
+    QHash<QString, DeferredResource>& getDeferredResources(ResourceType type);
+    const QHash<QString, DeferredResource>& getDeferredResources(ResourceType type) const;
+
+    std::vector<TrackedScheme> _schemes;
+    QHash<QString, DeferredResource> _deferredImagesets; // By object name
+    QHash<QString, DeferredResource> _deferredFonts;
+    QHash<QString, DeferredResource> _deferredLookNFeels;
+    QStringList _resourceDirs;
+    CEGUIResourceCache* _cache = nullptr;
+};
+
+#endif // CEGUIRESOURCETRACKER_H
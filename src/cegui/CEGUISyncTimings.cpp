@@ -0,0 +1,50 @@
+#include "src/cegui/CEGUISyncTimings.h"
+#include "qjsonobject.h"
+#include "qjsonarray.h"
+
+QString CEGUISyncTimings::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case Stage::SchemeParse: return "Scheme parse";
+        case Stage::ImagesetParse: return "Imageset parse";
+        case Stage::ImageDecode: return "Image decode";
+        case Stage::ImageCacheRead: return "Image cache read";
+        case Stage::TextureUpload: return "Texture upload";
+        case Stage::FontLoad: return "Font load";
+        case Stage::LookNFeelParse: return "LookNFeel parse";
+        case Stage::Factories: return "Factories and mappings";
+    }
+
+    return QString();
+}
+
+void CEGUISyncTimings::clear()
+{
+    _records.clear();
+    _totalTime = 0;
+}
+
+void CEGUISyncTimings::addRecord(Stage stage, const QString& schemeFile, const QString& fileName, qint64 nsec)
+{
+    _records.push_back({ stage, schemeFile, fileName, nsec });
+}
+
+QJsonDocument CEGUISyncTimings::toJson() const
+{
+    QJsonArray records;
+    for (const auto& record : _records)
+    {
+        QJsonObject recordObject;
+        recordObject.insert("stage", getStageName(record.stage));
+        recordObject.insert("scheme", record.schemeFile);
+        recordObject.insert("file", record.fileName);
+        recordObject.insert("ms", record.nsec / 1000000.0);
+        records.append(recordObject);
+    }
+
+    QJsonObject root;
+    root.insert("total_ms", _totalTime / 1000000.0);
+    root.insert("records", records);
+    return QJsonDocument(root);
+}
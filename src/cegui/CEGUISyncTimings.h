@@ -0,0 +1,53 @@
+#ifndef CEGUISYNCTIMINGS_H
+#define CEGUISYNCTIMINGS_H
+
+#include "qstring.h"
+#include "qjsondocument.h"
+#include <vector>
+
+// Time spent on each file during the last project synchronisation, broken down by loading stage.
+// Resources loaded on demand afterwards are appended to the same report. Used to find the assets
+// which make project opening slow.
+
+class CEGUISyncTimings
+{
+public:
+
+    enum class Stage
+    {
+        SchemeParse,
+        ImagesetParse,
+        ImageDecode,
+        ImageCacheRead,
+        TextureUpload,
+        FontLoad,
+        LookNFeelParse,
+        Factories
+    };
+
+    struct Record
+    {
+        Stage stage;
+        QString schemeFile;
+        QString fileName;
+        qint64 nsec;
+    };
+
+    static QString getStageName(Stage stage);
+
+    void clear();
+    void addRecord(Stage stage, const QString& schemeFile, const QString& fileName, qint64 nsec);
+    void setTotalTime(qint64 nsec) { _totalTime = nsec; }
+
+    const std::vector<Record>& getRecords() const { return _records; }
+    qint64 getTotalTime() const { return _totalTime; }
+
+    QJsonDocument toJson() const;
+
+protected:
+
+    std::vector<Record> _records;
+    qint64 _totalTime = 0;
+};
+
+#endif // CEGUISYNCTIMINGS_H
@@ -0,0 +1,103 @@
+#include "src/cegui/CEGUITextureDecoder.h"
+#include "src/cegui/CEGUIResourceCache.h"
+#include "src/cegui/CEGUISyncTimings.h"
+#include "src/cegui/CEGUIUtils.h"
+#include <CEGUI/System.h>
+#include <CEGUI/Renderer.h>
+#include <CEGUI/Texture.h>
+#include <QtConcurrent/qtconcurrentrun.h>
+#include "qelapsedtimer.h"
+
+// Runs in a worker thread
+static void decodeImage(const QString& imageFilePath, CEGUIResourceCache* cache, CEGUITextureDecoder::DecodedTexture& result)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (cache)
+    {
+        result.image = cache->loadTexture(imageFilePath);
+        result.fromCache = !result.image.isNull();
+    }
+
+    if (result.image.isNull())
+    {
+        result.image = QImage(imageFilePath);
+        if (!result.image.isNull())
+        {
+            // CEGUI expects tightly packed RGBA with straight alpha, which is what its own codecs produce
+            result.image = result.image.convertToFormat(QImage::Format_RGBA8888);
+
+            if (cache) cache->storeTexture(imageFilePath, result.image);
+        }
+    }
+
+    result.decodeTime = timer.nsecsElapsed();
+}
+
+CEGUITextureDecoder::~CEGUITextureDecoder()
+{
+    clear();
+}
+
+void CEGUITextureDecoder::enqueueImageset(const QString& imagesetFilePath)
+{
+    if (_pending.find(imagesetFilePath) != _pending.end()) return;
+
+    auto resolvePath = _resolvePath;
+    auto cache = _cache;
+    _pending.emplace(imagesetFilePath, QtConcurrent::run([imagesetFilePath, resolvePath, cache]()
+    {
+        DecodedTexture result;
+
+        const auto imagesets = cache ? cache->readElementAttributes(imagesetFilePath, "Imageset") :
+                                       CEGUIResourceTracker::readElementAttributes(imagesetFilePath, "Imageset");
+        if (imagesets.empty() || !resolvePath) return result;
+
+        const auto& attrs = imagesets.front();
+        QString resourceGroup = attrs.value("resourceGroup").toString();
+        if (resourceGroup.isEmpty()) resourceGroup = "imagesets";
+
+        // CEGUI names an imageset texture after the imageset itself
+        result.textureName = attrs.value("name").toString();
+        decodeImage(resolvePath(attrs.value("imagefile").toString(), resourceGroup), cache, result);
+        return result;
+    }));
+}
+
+// Must be called with the CEGUI OpenGL context current
+bool CEGUITextureDecoder::createTexture(const QString& filePath, const QString& schemeFile)
+{
+    auto it = _pending.find(filePath);
+    if (it == _pending.end()) return false;
+
+    const DecodedTexture decoded = it->second.result();
+    _pending.erase(it);
+
+    if (_timings)
+        _timings->addRecord(decoded.fromCache ? CEGUISyncTimings::Stage::ImageCacheRead : CEGUISyncTimings::Stage::ImageDecode,
+                            schemeFile, filePath, decoded.decodeTime);
+
+    if (decoded.textureName.isEmpty() || decoded.image.isNull()) return false;
+
+    auto renderer = CEGUI::System::getSingleton().getRenderer();
+    const auto textureName = CEGUIUtils::qStringToString(decoded.textureName);
+    if (renderer->isTextureDefined(textureName)) return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const CEGUI::Sizef size(static_cast<float>(decoded.image.width()), static_cast<float>(decoded.image.height()));
+    CEGUI::Texture& texture = renderer->createTexture(textureName, size);
+    texture.loadFromMemory(decoded.image.constBits(), size, CEGUI::Texture::PixelFormat::Rgba);
+
+    if (_timings) _timings->addRecord(CEGUISyncTimings::Stage::TextureUpload, schemeFile, filePath, timer.nsecsElapsed());
+
+    return true;
+}
+
+// Results not claimed are dropped, workers finish on their own
+void CEGUITextureDecoder::clear()
+{
+    _pending.clear();
+}
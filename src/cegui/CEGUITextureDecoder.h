@@ -0,0 +1,60 @@
+#ifndef CEGUITEXTUREDECODER_H
+#define CEGUITEXTUREDECODER_H
+
+#include "qstring.h"
+#include "qimage.h"
+#include "qfuture.h"
+#include "src/QtStdHash.h"
+#include <unordered_map>
+#include <functional>
+
+class CEGUIResourceCache;
+class CEGUISyncTimings;
+
+// Decodes project texture images in a thread pool ahead of loading them into CEGUI. The main
+// thread then only creates CEGUI textures from ready pixels, which is the only part requiring
+// an OpenGL context. CEGUI reuses a texture with the same name instead of loading the file again.
+
+class CEGUITextureDecoder
+{
+public:
+
+    struct DecodedTexture
+    {
+        QString textureName;
+        QImage image;
+        qint64 decodeTime = 0; // In nanoseconds
+        bool fromCache = false;
+    };
+
+    // Resolves a file name in a resource group to an absolute path, must be callable from workers
+    typedef std::function<QString(const QString& fileName, const QString& resourceGroup)> PathResolver;
+
+    ~CEGUITextureDecoder();
+
+    void setPathResolver(PathResolver resolver) { _resolvePath = resolver; }
+
+    // Decoded pixels are taken from and stored to the cache when it is set
+    void setCache(CEGUIResourceCache* cache) { _cache = cache; }
+
+    // Decoding and uploading of each texture is reported there when it is set
+    void setTimings(CEGUISyncTimings* timings) { _timings = timings; }
+
+    // Imageset texture name and image file are read from the imageset descriptor in a worker too
+    void enqueueImageset(const QString& imagesetFilePath);
+
+    // Waits for the decoding of a given file and creates a CEGUI texture from it. Does nothing if
+    // the file wasn't enqueued or failed to decode, CEGUI will load it itself and report errors.
+    bool createTexture(const QString& filePath, const QString& schemeFile = QString());
+
+    void clear();
+
+protected:
+
+    std::unordered_map<QString, QFuture<DecodedTexture>> _pending;
+    PathResolver _resolvePath;
+    CEGUIResourceCache* _cache = nullptr;
+    CEGUISyncTimings* _timings = nullptr;
+};
+
+#endif // CEGUITEXTUREDECODER_H
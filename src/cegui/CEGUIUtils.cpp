@@ -1,4 +1,5 @@
 #include "src/cegui/CEGUIUtils.h"
+#include "src/cegui/CEGUIManager.h"
 #include <CEGUI/widgets/GridLayoutContainer.h>
 #include <CEGUI/CoordConverter.h>
 #include <CEGUI/WindowManager.h>
@@ -145,6 +146,7 @@ CEGUI::Window* deserializeWidget(QDataStream& stream, CEGUI::Window* parent, siz
     {
         CEGUI::String widgetName = qStringToString(name);
         if (parent) widgetName = getUniqueChildWidgetName(*parent, widgetName);
+        CEGUIManager::Instance().ensureWidgetTypeResources(type);
         widget = CEGUI::WindowManager::getSingleton().createWindow(qStringToString(type), widgetName);
         if (parent)
         {
@@ -159,6 +161,7 @@ CEGUI::Window* deserializeWidget(QDataStream& stream, CEGUI::Window* parent, siz
         QString propertyName, propertyValue;
         stream >> propertyName;
         stream >> propertyValue;
+        CEGUIManager::Instance().ensurePropertyValueResources(propertyValue);
         widget->setProperty(qStringToString(propertyName), qStringToString(propertyValue));
     }
 
@@ -197,6 +197,11 @@ void EditorBase::initialize()
     _initialized = true;
     enableFileMonitoring(true);
     markAsUnchanged();
+
+    // Keep usages of project files up to date, only files changed since the last scan are read again
+    auto& dependencyGraph = CEGUIManager::Instance().getDependencyGraph();
+    if (CEGUIManager::Instance().isProjectLoaded() && dependencyGraph.isReady())
+        dependencyGraph.scan(*CEGUIManager::Instance().getCurrentProject());
 }
 
 // Cleans up after itself, this is usually called when you want the editor to close
@@ -300,6 +305,11 @@ bool EditorBase::saveAs(const QString& targetPath)
     enableFileMonitoring(true);
     markAsUnchanged();
 
+    // Keep usages of project files up to date, only files changed since the last scan are read again
+    auto& dependencyGraph = CEGUIManager::Instance().getDependencyGraph();
+    if (CEGUIManager::Instance().isProjectLoaded() && dependencyGraph.isReady())
+        dependencyGraph.scan(*CEGUIManager::Instance().getCurrentProject());
+
     if (prevFilePath != _filePath)
     {
         _labelText = QFileInfo(_filePath).fileName();
@@ -2,6 +2,7 @@
 #include "src/editors/layout/LayoutVisualMode.h"
 #include "src/editors/layout/LayoutEditor.h"
 #include "src/ui/layout/LayoutManipulator.h"
+#include "src/cegui/CEGUIManager.h"
 #include "src/cegui/CEGUIUtils.h"
 #include <CEGUI/WindowManager.h>
 
@@ -29,6 +30,7 @@ bool LayoutCodeMode::propagateNativeCode(const QString& code)
     {
         try
         {
+            CEGUIManager::Instance().ensureLayoutResources(code);
             CEGUI::Window* widget = CEGUI::WindowManager::getSingleton().loadLayoutFromString(CEGUIUtils::qStringToString(code));
             auto root = new LayoutManipulator(visualMode, nullptr, widget);
             root->updateFromWidget();
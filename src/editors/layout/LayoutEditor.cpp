@@ -2,6 +2,7 @@
 #include "src/editors/layout/LayoutCodeMode.h"
 #include "src/editors/layout/LayoutVisualMode.h"
 #include "src/editors/layout/LayoutPreviewerMode.h"
+#include "src/editors/layout/LayoutMultiPreviewMode.h"
 #include "src/cegui/CEGUIManager.h"
 #include "src/cegui/CEGUIProject.h"
 #include "src/cegui/CEGUIUtils.h"
@@ -39,6 +40,9 @@ LayoutEditor::LayoutEditor(const QString& filePath)
     //       and if A = C it would eat the undo command entirely.
     auto previewer = new LayoutPreviewerMode(*this);
     tabs.addTab(previewer, "Live Preview");
+
+    auto multiPreviewer = new LayoutMultiPreviewMode(*this);
+    tabs.addTab(multiPreviewer, "Resolutions");
 }
 
 void LayoutEditor::initialize()
@@ -65,6 +69,7 @@ void LayoutEditor::initialize()
 
             if (rawData.size() > 0)
             {
+                CEGUIManager::Instance().ensureLayoutResources(QString::fromUtf8(rawData));
                 CEGUI::Window* widget = CEGUI::WindowManager::getSingleton().loadLayoutFromString(CEGUIUtils::qStringToString(rawData));
                 auto root = new LayoutManipulator(*visualMode, nullptr, widget);
                 root->updateFromWidget();
@@ -197,7 +202,7 @@ void LayoutEditor::createSettings(Settings& mgr)
     secVisual->addEntry(std::move(entry));
 
     entry.reset(new SettingsEntry(*secVisual, "prevent_manipulator_overlap", false, "Prevent manipulator overlap",
-                                  "Only enable if you have a very fast computer and only edit small layouts. Very performance intensive!",
+                                  "Hides parts of outlines covered by widgets above them.",
                                   "checkbox", false, 0));
     secVisual->addEntry(std::move(entry));
 
@@ -260,6 +265,14 @@ void LayoutEditor::createSettings(Settings& mgr)
                                   "deal with them at all. Only use if you know what you are doing! This might clutter the interface a lot.",
                                   "checkbox", false, 11));
     secVisual->addEntry(std::move(entry));
+
+    auto secPreview = catImageset->createSection("preview", "Preview");
+
+    entry.reset(new SettingsEntry(*secPreview, "resolutions", "800x600, 1024x768, 1280x720, 1280x1024, 1920x1080, 2560x1440",
+                                  "Resolutions", "Resolutions the 'Resolutions' mode shows the layout at side by side, as WIDTHxHEIGHT\n"
+                                  "separated by commas. Applies the next time the mode is switched to.",
+                                  "string", false, 1));
+    secPreview->addEntry(std::move(entry));
 }
 
 void LayoutEditor::createActions(Application& app)
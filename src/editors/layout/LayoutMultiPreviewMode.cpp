@@ -0,0 +1,122 @@
+#include "src/editors/layout/LayoutMultiPreviewMode.h"
+#include "src/editors/layout/LayoutVisualMode.h"
+#include "src/editors/layout/LayoutEditor.h"
+#include "src/ui/CEGUIGraphicsScene.h"
+#include "src/ui/CEGUIGraphicsView.h"
+#include "src/util/Settings.h"
+#include "src/util/Utils.h"
+#include "src/Application.h"
+#include "qboxlayout.h"
+#include "qgridlayout.h"
+#include "qlabel.h"
+#include "qevent.h"
+#include <CEGUI/Window.h>
+#include <CEGUI/WindowManager.h>
+#include <CEGUI/GUIContext.h>
+#include <cmath>
+
+LayoutMultiPreviewMode::LayoutMultiPreviewMode(LayoutEditor& editor, QWidget* parent)
+    : QWidget(parent)
+    , IEditMode(editor)
+{
+    _grid = new QGridLayout(this);
+    _grid->setContentsMargins(0, 0, 0, 0);
+    setLayout(_grid);
+}
+
+LayoutMultiPreviewMode::~LayoutMultiPreviewMode()
+{
+    clearPreviews();
+}
+
+// Scenes are created anew each time, so that setting changes apply and no GPU memory is held while inactive
+void LayoutMultiPreviewMode::activate(MainWindow& mainWindow)
+{
+    IEditMode::activate(mainWindow);
+
+    assert(_previews.empty());
+
+    auto currentRootWidget = static_cast<LayoutEditor&>(_editor).getVisualMode()->getRootWidget();
+
+    const auto resolutions = getResolutions();
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(resolutions.size())))));
+
+    for (size_t i = 0; i < resolutions.size(); ++i)
+    {
+        const QSize& resolution = resolutions[i];
+
+        Preview preview;
+        preview.cell = new QWidget(this);
+
+        auto cellLayout = new QVBoxLayout(preview.cell);
+        cellLayout->setContentsMargins(2, 2, 2, 2);
+        cellLayout->addWidget(new QLabel(QString("%1x%2").arg(resolution.width()).arg(resolution.height()), preview.cell));
+
+        preview.scene = new CEGUIGraphicsScene(nullptr, static_cast<float>(resolution.width()), static_cast<float>(resolution.height()));
+
+        preview.view = new CEGUIGraphicsView(preview.cell);
+        preview.view->setContinuousRendering(false);
+        preview.view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        preview.view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        preview.view->setScene(preview.scene);
+        preview.view->installEventFilter(this);
+        cellLayout->addWidget(preview.view, 1);
+
+        // Lets clone so we don't affect the layout at all, each context needs its own copy
+        preview.rootWidget = currentRootWidget ? currentRootWidget->clone() : nullptr;
+        preview.scene->getCEGUIContext()->setRootWindow(preview.rootWidget);
+
+        _grid->addWidget(preview.cell, static_cast<int>(i) / columns, static_cast<int>(i) % columns);
+        _previews.push_back(preview);
+    }
+}
+
+bool LayoutMultiPreviewMode::deactivate(MainWindow& mainWindow)
+{
+    clearPreviews();
+
+    return IEditMode::deactivate(mainWindow);
+}
+
+// Whole context is always visible whatever the cell size is
+bool LayoutMultiPreviewMode::eventFilter(QObject* watched, QEvent* event)
+{
+    if (event->type() == QEvent::Resize)
+    {
+        for (const auto& preview : _previews)
+        {
+            if (preview.view != watched) continue;
+
+            const QRectF contextRect(0.0, 0.0, static_cast<qreal>(preview.scene->getContextWidth()),
+                                     static_cast<qreal>(preview.scene->getContextHeight()));
+            preview.view->fitInView(contextRect, Qt::KeepAspectRatio);
+            break;
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+void LayoutMultiPreviewMode::clearPreviews()
+{
+    for (const auto& preview : _previews)
+    {
+        if (preview.rootWidget)
+        {
+            preview.scene->getCEGUIContext()->setRootWindow(nullptr);
+            CEGUI::WindowManager::getSingleton().destroyWindow(preview.rootWidget);
+        }
+
+        // The view must go before the scene it shows
+        delete preview.cell;
+        delete preview.scene;
+    }
+
+    _previews.clear();
+}
+
+std::vector<QSize> LayoutMultiPreviewMode::getResolutions()
+{
+    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+    return Utils::parseResolutions(settings->getEntryValue("layout/preview/resolutions").toString());
+}
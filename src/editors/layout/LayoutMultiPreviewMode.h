@@ -0,0 +1,52 @@
+#ifndef LAYOUTMULTIPREVIEWMODE_H
+#define LAYOUTMULTIPREVIEWMODE_H
+
+#include "src/editors/MultiModeEditor.h"
+#include <QWidget>
+
+// Shows the layout at several resolutions side by side, each one fitted into its cell of a grid.
+// Every resolution has its own scene with a GUI context and a render target, scenes are rendered
+// only when their CEGUI content changes. Resolutions are taken from the settings.
+
+namespace CEGUI
+{
+    class Window;
+}
+
+class LayoutEditor;
+class CEGUIGraphicsScene;
+class CEGUIGraphicsView;
+class QGridLayout;
+
+class LayoutMultiPreviewMode : public QWidget, public IEditMode
+{
+    Q_OBJECT
+
+public:
+
+    explicit LayoutMultiPreviewMode(LayoutEditor& editor, QWidget *parent = nullptr);
+    virtual ~LayoutMultiPreviewMode() override;
+
+    virtual void activate(MainWindow& mainWindow) override;
+    virtual bool deactivate(MainWindow& mainWindow) override;
+
+protected:
+
+    struct Preview
+    {
+        QWidget* cell;
+        CEGUIGraphicsView* view;
+        CEGUIGraphicsScene* scene;
+        CEGUI::Window* rootWidget;
+    };
+
+    static std::vector<QSize> getResolutions();
+
+    virtual bool eventFilter(QObject* watched, QEvent* event) override;
+    void clearPreviews();
+
+    QGridLayout* _grid = nullptr;
+    std::vector<Preview> _previews;
+};
+
+#endif // LAYOUTMULTIPREVIEWMODE_H
@@ -0,0 +1,210 @@
+#include "src/editors/layout/LayoutScreenshotExporter.h"
+#include "src/cegui/CEGUIManager.h"
+#include "src/cegui/CEGUIUtils.h"
+#include "src/ui/CEGUIGraphicsScene.h"
+#include <CEGUI/Window.h>
+#include <CEGUI/WindowManager.h>
+#include <CEGUI/GUIContext.h>
+#include <QtConcurrent/qtconcurrentrun.h>
+#include "qfuturewatcher.h"
+#include "qsavefile.h"
+#include "qfileinfo.h"
+#include "qimage.h"
+#include "qtimer.h"
+#include "qdir.h"
+
+// Runs in a worker thread. Pixels come straight from the readback, bottom-up.
+static bool saveScreenshot(const QImage& pixels, const QString& filePath)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QFile::WriteOnly)) return false;
+    return pixels.mirrored().save(&file, "PNG", 50) && file.commit();
+}
+
+LayoutScreenshotExporter::LayoutScreenshotExporter(const QStringList& layoutFilePaths, const QString& layoutsDirectory,
+                                                   const std::vector<QSize>& resolutions, const QString& outputDirectory, QObject* parent)
+    : QObject(parent)
+    , _layoutFilePaths(layoutFilePaths)
+    , _layoutsDirectory(layoutsDirectory)
+    , _resolutions(resolutions)
+    , _outputDirectory(outputDirectory)
+{
+}
+
+LayoutScreenshotExporter::~LayoutScreenshotExporter()
+{
+    // Workers only write files, nothing of ours is touched by them
+    _encodePool.waitForDone();
+    delete _scene;
+    unloadLayout();
+}
+
+void LayoutScreenshotExporter::start()
+{
+    CEGUIManager::Instance().ensureCEGUIInitialized();
+    renderNext();
+}
+
+// Encoding of already rendered screenshots is not interrupted, they are saved before finishing
+void LayoutScreenshotExporter::cancel()
+{
+    _cancelled = true;
+    renderNext();
+}
+
+void LayoutScreenshotExporter::renderNext()
+{
+    // One readback at a time, the next screenshot is rendered when it arrives
+    if (_scene || _finished) return;
+
+    if (_cancelled || _layoutIndex >= _layoutFilePaths.size() || _resolutions.empty())
+    {
+        unloadLayout();
+        if (!_encoding)
+        {
+            _finished = true;
+            emit finished();
+        }
+        return;
+    }
+
+    // Too many images are waiting for encoding, the next encoded one resumes rendering
+    if (_encoding >= 2 * _encodePool.maxThreadCount()) return;
+
+    const QString& layoutFilePath = _layoutFilePaths[_layoutIndex];
+    if (!_rootWidget && !loadLayout(layoutFilePath))
+    {
+        _done += static_cast<int>(_resolutions.size() - _resolutionIndex);
+        emit progressChanged(_done);
+
+        ++_layoutIndex;
+        _resolutionIndex = 0;
+        QTimer::singleShot(0, this, &LayoutScreenshotExporter::renderNext);
+        return;
+    }
+
+    const QSize& resolution = _resolutions[_resolutionIndex];
+    const QString filePath = getScreenshotFilePath(layoutFilePath, resolution);
+
+    _scene = new CEGUIGraphicsScene(nullptr, static_cast<float>(resolution.width()), static_cast<float>(resolution.height()));
+    _scene->getCEGUIContext()->setRootWindow(_rootWidget);
+
+    // The context is rendered right here, so the layout may be moved on before pixels arrive
+    const bool started = _scene->readCEGUIScreenshot([this, filePath](const QImage& pixels)
+    {
+        onScreenshotRead(pixels, filePath);
+    });
+
+    _scene->getCEGUIContext()->setRootWindow(nullptr);
+
+    if (++_resolutionIndex >= _resolutions.size())
+    {
+        ++_layoutIndex;
+        _resolutionIndex = 0;
+        unloadLayout();
+    }
+
+    if (!started)
+    {
+        delete _scene;
+        _scene = nullptr;
+
+        _errors.append(QString("Can't render %1").arg(filePath));
+        ++_done;
+        emit progressChanged(_done);
+        QTimer::singleShot(0, this, &LayoutScreenshotExporter::renderNext);
+    }
+}
+
+void LayoutScreenshotExporter::onScreenshotRead(const QImage& pixels, const QString& filePath)
+{
+    // We are called by the scene, it can't be deleted right away
+    _scene->deleteLater();
+    _scene = nullptr;
+
+    if (pixels.isNull())
+    {
+        _errors.append(QString("Can't read pixels of %1").arg(filePath));
+        onScreenshotDone();
+        return;
+    }
+
+    ++_encoding;
+
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, filePath]()
+    {
+        --_encoding;
+
+        if (watcher->result())
+            ++_saved;
+        else
+            _errors.append(QString("Can't write %1").arg(filePath));
+
+        watcher->deleteLater();
+        onScreenshotDone();
+    });
+    watcher->setFuture(QtConcurrent::run(&_encodePool, saveScreenshot, pixels, filePath));
+
+    renderNext();
+}
+
+void LayoutScreenshotExporter::onScreenshotDone()
+{
+    ++_done;
+    emit progressChanged(_done);
+    renderNext();
+}
+
+bool LayoutScreenshotExporter::loadLayout(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        _errors.append(QString("Can't read %1").arg(filePath));
+        return false;
+    }
+
+    const QByteArray rawData = file.readAll();
+
+    try
+    {
+        CEGUIManager::Instance().ensureLayoutResources(QString::fromUtf8(rawData));
+        _rootWidget = CEGUI::WindowManager::getSingleton().loadLayoutFromString(CEGUIUtils::qStringToString(rawData));
+    }
+    catch (const std::exception& e)
+    {
+        _errors.append(QString("%1: %2").arg(filePath, e.what()));
+        return false;
+    }
+
+    if (!_rootWidget)
+    {
+        _errors.append(QString("%1: layout has no widgets").arg(filePath));
+        return false;
+    }
+
+    return true;
+}
+
+void LayoutScreenshotExporter::unloadLayout()
+{
+    if (!_rootWidget) return;
+
+    CEGUI::WindowManager::getSingleton().destroyWindow(_rootWidget);
+    CEGUI::WindowManager::getSingleton().cleanDeadPool();
+    _rootWidget = nullptr;
+}
+
+// Layouts from subdirectories get the relative path in the name, so names never clash
+QString LayoutScreenshotExporter::getScreenshotFilePath(const QString& layoutFilePath, const QSize& resolution) const
+{
+    QString name = QDir(_layoutsDirectory).relativeFilePath(layoutFilePath);
+    if (name.startsWith("..")) name = QFileInfo(layoutFilePath).fileName();
+
+    const QString suffix = QFileInfo(name).suffix();
+    if (!suffix.isEmpty()) name.chop(suffix.size() + 1);
+    name.replace('/', '_');
+
+    return QDir(_outputDirectory).filePath(QString("%1-%2x%3.png").arg(name).arg(resolution.width()).arg(resolution.height()));
+}
@@ -0,0 +1,72 @@
+#ifndef LAYOUTSCREENSHOTEXPORTER_H
+#define LAYOUTSCREENSHOTEXPORTER_H
+
+#include "qobject.h"
+#include "qstringlist.h"
+#include "qthreadpool.h"
+#include "qsize.h"
+#include <vector>
+
+// Saves screenshots of every given layout at every given resolution to a directory. Screenshots
+// are rendered one at a time, each in its own short-lived scene like in the multi-resolution
+// preview. Pixels are read back asynchronously and encoded in a thread pool while the next one
+// is rendered. Images waiting for encoding are limited, so memory stays bounded for big batches.
+
+namespace CEGUI
+{
+    class Window;
+}
+
+class CEGUIGraphicsScene;
+class QImage;
+
+class LayoutScreenshotExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    LayoutScreenshotExporter(const QStringList& layoutFilePaths, const QString& layoutsDirectory,
+                             const std::vector<QSize>& resolutions, const QString& outputDirectory, QObject* parent = nullptr);
+    virtual ~LayoutScreenshotExporter() override;
+
+    void start();
+    void cancel();
+
+    int getTotalCount() const { return _layoutFilePaths.size() * static_cast<int>(_resolutions.size()); }
+    int getSavedCount() const { return _saved; }
+    const QStringList& getErrors() const { return _errors; }
+
+signals:
+
+    void progressChanged(int done);
+    void finished();
+
+protected:
+
+    void renderNext();
+    void onScreenshotRead(const QImage& pixels, const QString& filePath);
+    void onScreenshotDone();
+    bool loadLayout(const QString& filePath);
+    void unloadLayout();
+    QString getScreenshotFilePath(const QString& layoutFilePath, const QSize& resolution) const;
+
+    QStringList _layoutFilePaths;
+    QString _layoutsDirectory;
+    std::vector<QSize> _resolutions;
+    QString _outputDirectory;
+    QThreadPool _encodePool;
+
+    CEGUIGraphicsScene* _scene = nullptr; // Has a readback pending
+    CEGUI::Window* _rootWidget = nullptr;
+    int _layoutIndex = 0;
+    size_t _resolutionIndex = 0;
+    int _encoding = 0;
+    int _done = 0;
+    int _saved = 0;
+    QStringList _errors;
+    bool _cancelled = false;
+    bool _finished = false;
+};
+
+#endif // LAYOUTSCREENSHOTEXPORTER_H
@@ -4,6 +4,7 @@
 #include "src/ui/layout/LayoutManipulator.h"
 #include "src/ui/layout/WidgetHierarchyDockWidget.h"
 #include "src/ui/layout/WidgetHierarchyItem.h"
+#include "src/cegui/CEGUIManager.h"
 #include "src/cegui/CEGUIUtils.h"
 #include <CEGUI/widgets/GridLayoutContainer.h>
 #include <CEGUI/WindowManager.h>
@@ -43,8 +44,7 @@ static LayoutManipulator* CreateManipulatorFromDataStream(LayoutVisualMode& visu
     }
 
     manipulator->createChildManipulators(true, false);
-    manipulator->updateFromWidget(false, true);
-    manipulator->setSelected(true);
+    manipulator->scheduleUpdateFromWidget(false, true);
 
     return manipulator;
 }
@@ -68,13 +68,15 @@ void LayoutMoveCommand::undo()
         auto manipulator = _visualMode.getScene()->getManipulatorByPath(rec.path);
         assert(manipulator);
         manipulator->getWidget()->setPosition(rec.oldPos);
-        manipulator->updateFromWidget(false, true);
+        manipulator->scheduleUpdateFromWidget(false, true);
 
         // In case the pixel position didn't change but the absolute and negative components changed and canceled each other out
         manipulator->update();
 
         manipulator->updatePropertiesFromWidget({"Position", "Area"});
     }
+
+    _visualMode.getScene()->flushManipulatorUpdates();
 }
 
 void LayoutMoveCommand::redo()
@@ -84,7 +86,7 @@ void LayoutMoveCommand::redo()
         auto manipulator = _visualMode.getScene()->getManipulatorByPath(rec.path);
         assert(manipulator);
         manipulator->getWidget()->setPosition(rec.newPos);
-        manipulator->updateFromWidget(false, true);
+        manipulator->scheduleUpdateFromWidget(false, true);
 
         // In case the pixel position didn't change but the absolute and negative components changed and canceled each other out
         manipulator->update();
@@ -92,6 +94,8 @@ void LayoutMoveCommand::redo()
         manipulator->updatePropertiesFromWidget({"Position", "Area"});
     }
 
+    _visualMode.getScene()->flushManipulatorUpdates();
+
     QUndoCommand::redo();
 }
 
@@ -152,13 +156,15 @@ void LayoutResizeCommand::undo()
         assert(manipulator);
         manipulator->getWidget()->setPosition(rec.oldPos);
         manipulator->getWidget()->setSize(rec.oldSize);
-        manipulator->updateFromWidget(false, true);
+        manipulator->scheduleUpdateFromWidget(false, true);
 
         // In case the pixel position didn't change but the absolute and negative components changed and canceled each other out
         manipulator->update();
 
         manipulator->updatePropertiesFromWidget({"Size", "Position", "Area"});
     }
+
+    _visualMode.getScene()->flushManipulatorUpdates();
 }
 
 void LayoutResizeCommand::redo()
@@ -169,7 +175,7 @@ void LayoutResizeCommand::redo()
         assert(manipulator);
         manipulator->getWidget()->setPosition(rec.newPos);
         manipulator->getWidget()->setSize(rec.newSize);
-        manipulator->updateFromWidget(false, true);
+        manipulator->scheduleUpdateFromWidget(false, true);
 
         // In case the pixel position didn't change but the absolute and negative components changed and canceled each other out
         manipulator->update();
@@ -177,6 +183,8 @@ void LayoutResizeCommand::redo()
         manipulator->updatePropertiesFromWidget({"Size", "Position", "Area"});
     }
 
+    _visualMode.getScene()->flushManipulatorUpdates();
+
     QUndoCommand::redo();
 }
 
@@ -259,15 +267,22 @@ void LayoutDeleteCommand::undo()
 {
     QUndoCommand::undo();
 
+    std::vector<LayoutManipulator*> restored;
     for (auto& rec : _records)
     {
         const int sepPos = rec.path.lastIndexOf('/');
         LayoutManipulator* parent = (sepPos < 0) ? nullptr : _visualMode.getScene()->getManipulatorByPath(rec.path.left(sepPos));
 
         QDataStream stream(&rec.data, QIODevice::ReadOnly);
-        CreateManipulatorFromDataStream(_visualMode, parent, stream, rec.indexInParent);
+        if (auto manipulator = CreateManipulatorFromDataStream(_visualMode, parent, stream, rec.indexInParent))
+            restored.push_back(manipulator);
     }
 
+    // Selection handlers and the hierarchy need up to date geometry
+    _visualMode.getScene()->flushManipulatorUpdates();
+    for (auto manipulator : restored)
+        manipulator->setSelected(true);
+
     _visualMode.getHierarchyDockWidget()->refresh();
 }
 
@@ -276,6 +291,7 @@ void LayoutDeleteCommand::redo()
     for (const auto& rec : _records)
         _visualMode.getScene()->deleteWidgetByPath(rec.path);
 
+    _visualMode.getScene()->flushManipulatorUpdates();
     _visualMode.getScene()->updatePropertySet();
 
     QUndoCommand::redo();
@@ -301,11 +317,14 @@ void LayoutCreateCommand::undo()
 
     const QString fullPath = _parentPath.isEmpty() ? _name : _parentPath + '/' + _name;
     _visualMode.getScene()->deleteWidgetByPath(fullPath);
+    _visualMode.getScene()->flushManipulatorUpdates();
     _visualMode.getScene()->updatePropertySet();
 }
 
 void LayoutCreateCommand::redo()
 {
+    CEGUIManager::Instance().ensureWidgetTypeResources(_type);
+
     CEGUI::Window* widget = CEGUI::WindowManager::getSingleton().createWindow(
                 CEGUIUtils::qStringToString(_type), CEGUIUtils::qStringToString(_name));
 
@@ -394,6 +413,8 @@ void LayoutPropertyEditCommand::undo()
 
     for (const auto& rec : _records)
         setProperty(rec.path, rec.oldValue, properties);
+
+    _visualMode.getScene()->flushManipulatorUpdates();
 }
 
 void LayoutPropertyEditCommand::redo()
@@ -404,6 +425,8 @@ void LayoutPropertyEditCommand::redo()
     for (const auto& rec : _records)
         setProperty(rec.path, rec.newValue, properties);
 
+    _visualMode.getScene()->flushManipulatorUpdates();
+
     QUndoCommand::redo();
 }
 
@@ -445,8 +468,9 @@ void LayoutPropertyEditCommand::setProperty(const QString& widgetPath, const CEG
 
     try
     {
+        CEGUIManager::Instance().ensurePropertyValueResources(CEGUIUtils::stringToQString(value));
         manipulator->getWidget()->setProperty(_propertyName, value);
-        manipulator->updateFromWidget(false, true);
+        manipulator->scheduleUpdateFromWidget(false, true);
         manipulator->update();
         manipulator->updatePropertiesFromWidget(propertiesToUpdate);
     }
@@ -499,10 +523,12 @@ void LayoutHorizontalAlignCommand::undo()
     {
         auto manipulator = _visualMode.getScene()->getManipulatorByPath(rec.path);
         manipulator->getWidget()->setHorizontalAlignment(rec.oldAlignment);
-        manipulator->updateFromWidget();
+        manipulator->scheduleUpdateFromWidget();
 
         manipulator->updatePropertiesFromWidget({"HorizontalAlignment"});
     }
+
+    _visualMode.getScene()->flushManipulatorUpdates();
 }
 
 void LayoutHorizontalAlignCommand::redo()
@@ -511,11 +537,13 @@ void LayoutHorizontalAlignCommand::redo()
     {
         auto manipulator = _visualMode.getScene()->getManipulatorByPath(rec.path);
         manipulator->getWidget()->setHorizontalAlignment(_newAlignment);
-        manipulator->updateFromWidget();
+        manipulator->scheduleUpdateFromWidget();
 
         manipulator->updatePropertiesFromWidget({"HorizontalAlignment"});
     }
 
+    _visualMode.getScene()->flushManipulatorUpdates();
+
     QUndoCommand::redo();
 }
 
@@ -574,10 +602,12 @@ void LayoutVerticalAlignCommand::undo()
     {
         auto manipulator = _visualMode.getScene()->getManipulatorByPath(rec.path);
         manipulator->getWidget()->setVerticalAlignment(rec.oldAlignment);
-        manipulator->updateFromWidget();
+        manipulator->scheduleUpdateFromWidget();
 
         manipulator->updatePropertiesFromWidget({"VerticalAlignment"});
     }
+
+    _visualMode.getScene()->flushManipulatorUpdates();
 }
 
 void LayoutVerticalAlignCommand::redo()
@@ -586,11 +616,13 @@ void LayoutVerticalAlignCommand::redo()
     {
         auto manipulator = _visualMode.getScene()->getManipulatorByPath(rec.path);
         manipulator->getWidget()->setVerticalAlignment(_newAlignment);
-        manipulator->updateFromWidget();
+        manipulator->scheduleUpdateFromWidget();
 
         manipulator->updatePropertiesFromWidget({"VerticalAlignment"});
     }
 
+    _visualMode.getScene()->flushManipulatorUpdates();
+
     QUndoCommand::redo();
 }
 
@@ -734,10 +766,11 @@ void LayoutMoveInHierarchyCommand::undo()
             oldParentManipulator->getWidget()->moveChildToIndex(currIndex, destIndex);
 
         // Update widget and its previous parent (the second is mostly for the layout container case)
-        widgetManipulator->updateFromWidget(true, true);
-        if (newParentManipulator) newParentManipulator->updateFromWidget(true, true);
+        widgetManipulator->scheduleUpdateFromWidget(true, true);
+        if (newParentManipulator) newParentManipulator->scheduleUpdateFromWidget(true, true);
     }
 
+    _visualMode.getScene()->flushManipulatorUpdates();
     _visualMode.getHierarchyDockWidget()->refresh();
 }
 
@@ -784,10 +817,11 @@ void LayoutMoveInHierarchyCommand::redo()
             newParentManipulator->getWidget()->moveChildToIndex(widgetManipulator->getWidget(), rec.newChildIndex);
 
         // Update widget and its previous parent (the second is mostly for the layout container case)
-        widgetManipulator->updateFromWidget(true, true);
-        if (oldParentManipulator) oldParentManipulator->updateFromWidget(true, true);
+        widgetManipulator->scheduleUpdateFromWidget(true, true);
+        if (oldParentManipulator) oldParentManipulator->scheduleUpdateFromWidget(true, true);
     }
 
+    _visualMode.getScene()->flushManipulatorUpdates();
     _visualMode.getHierarchyDockWidget()->refresh();
 
     QUndoCommand::redo();
@@ -811,6 +845,7 @@ void LayoutPasteCommand::undo()
     for (const QString& path : _createdWidgets)
         _visualMode.getScene()->deleteWidgetByPath(path);
 
+    _visualMode.getScene()->flushManipulatorUpdates();
     _visualMode.getScene()->updatePropertySet();
 
     _createdWidgets.clear();
@@ -823,6 +858,7 @@ void LayoutPasteCommand::redo()
 
     scene->clearSelection();
 
+    std::vector<LayoutManipulator*> pasted;
     QDataStream stream(&_data, QIODevice::ReadOnly);
     while (!stream.atEnd())
     {
@@ -834,12 +870,20 @@ void LayoutPasteCommand::redo()
 
         LayoutManipulator* manipulator = CreateManipulatorFromDataStream(_visualMode, target, stream);
         if (manipulator)
+        {
             _createdWidgets.push_back(manipulator->getWidgetPath());
+            pasted.push_back(manipulator);
+        }
     }
 
     // Update the topmost parent widget recursively to get possible resize or
     // repositions of the pasted widgets into the manipulator data.
-    if (target) target->updateFromWidget(true, true);
+    if (target) target->scheduleUpdateFromWidget(true, true);
+
+    // Selection handlers and the hierarchy need up to date geometry
+    scene->flushManipulatorUpdates();
+    for (auto manipulator : pasted)
+        manipulator->setSelected(true);
 
     _visualMode.getHierarchyDockWidget()->refresh();
 
@@ -923,9 +967,11 @@ void MoveInParentWidgetListCommand::undo()
         parentManipulator->getWidget()->swapChildren(oldPos, newPos);
         assert(newPos == parentManipulator->getWidget()->getChildIndex(manipulator->getWidget()));
 
-        parentManipulator->updateFromWidget(true, true);
+        parentManipulator->scheduleUpdateFromWidget(true, true);
         parentManipulator->getTreeItem()->refreshOrderingData();
     }
+
+    _visualMode.getScene()->flushManipulatorUpdates();
 }
 
 void MoveInParentWidgetListCommand::redo()
@@ -942,10 +988,12 @@ void MoveInParentWidgetListCommand::redo()
         parentManipulator->getWidget()->swapChildren(oldPos, newPos);
         assert(newPos == parentManipulator->getWidget()->getChildIndex(manipulator->getWidget()));
 
-        parentManipulator->updateFromWidget(true, true);
+        parentManipulator->scheduleUpdateFromWidget(true, true);
         parentManipulator->getTreeItem()->refreshOrderingData();
     }
 
+    _visualMode.getScene()->flushManipulatorUpdates();
+
     QUndoCommand::redo();
 }
 
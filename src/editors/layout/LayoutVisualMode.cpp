@@ -29,6 +29,9 @@
 #include <qurl.h>
 #include <qclipboard.h>
 #include <qbuffer.h>
+#include <qsavefile.h>
+#include <qfuturewatcher.h>
+#include <QtConcurrent/qtconcurrentrun.h>
 #include <unordered_set>
 #include <qinputdialog.h>
 
@@ -505,39 +508,42 @@ bool LayoutVisualMode::isSnapGridEnabled() const
     return actionSnapGrid ? actionSnapGrid->isChecked() : false;
 }
 
-void LayoutVisualMode::takeScreenshot()
+// Everything needed to encode a screenshot without accessing settings from a worker thread
+struct ScreenshotOptions
 {
-    if (!scene) return;
+    QString filePath; // Empty if not saved to file
+    bool needChecker = false;
+    bool useQtImage = true;
+    int checkerWidth = 5;
+    int checkerHeight = 5;
+    QColor checkerFirstColour;
+    QColor checkerSecondColour;
+};
+
+struct EncodedScreenshot
+{
+    bool saved = false;
+    QByteArray png;
+    QImage qtImage;
+};
 
-    QImage screenshot = scene->getCEGUIScreenshot();
-    if (screenshot.isNull()) return;
+// Runs in a worker thread. Pixels come straight from the readback, bottom-up.
+static EncodedScreenshot encodeScreenshot(const QImage& pixels, const ScreenshotOptions& options)
+{
+    EncodedScreenshot result;
 
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+    QImage screenshot = pixels.mirrored().convertToFormat(QImage::Format_ARGB32_Premultiplied);
 
     // Save to file
 
-    if (settings->getEntryValue("cegui/screenshots/save", true).toBool())
+    if (!options.filePath.isEmpty())
     {
-        // TODO: add project subfolder (need name), optional through settings
-        const QDir dir(QDir(QStandardPaths::writableLocation(QStandardPaths::PicturesLocation)).filePath("CEED"));
-        const QString fileName = QString("%1-%2x%3-%4.png")
-                .arg(QFileInfo(getEditor().getFilePath()).baseName())
-                .arg(static_cast<int>(scene->getContextWidth()))
-                .arg(static_cast<int>(scene->getContextHeight()))
-                .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
-        const QString filePath = dir.filePath(fileName);
-
-        dir.mkpath(".");
-        if (screenshot.save(filePath, "PNG", 50))
+        QSaveFile file(options.filePath);
+        if (file.open(QFile::WriteOnly))
         {
-            const auto action = settings->getEntryValue("cegui/screenshots/after_save_action").toInt();
-            switch (action)
-            {
-                // TODO: https://stackoverflow.com/questions/3490336/how-to-reveal-in-finder-or-show-in-explorer-with-qt
-                case 0: QDesktopServices::openUrl(QUrl::fromLocalFile(dir.path())); break;
-                case 1: QDesktopServices::openUrl(QUrl::fromLocalFile(filePath)); break;
-                default: break;
-            }
+            QBuffer buffer(&result.png);
+            if (buffer.open(QIODevice::WriteOnly) && screenshot.save(&buffer, "PNG", 50))
+                result.saved = (file.write(result.png) == result.png.size() && file.commit());
         }
     }
 
@@ -559,42 +565,100 @@ void LayoutVisualMode::takeScreenshot()
     // Please, do something with it, if you can. In the meantime I leave here a couple of
     // settings that can be used to paste to different software.
 
-    QMimeData* data = new QMimeData();
-
-    const auto checkerWidth = settings->getEntryValue("cegui/background/checker_width").toInt();
-    const auto checkerHeight = settings->getEntryValue("cegui/background/checker_height").toInt();
-    const auto checkerFirstColour = settings->getEntryValue("cegui/background/first_colour").value<QColor>();
-    const auto checkerSecondColour = settings->getEntryValue("cegui/background/second_colour").value<QColor>();
-    const bool needChecker = settings->getEntryValue("cegui/screenshots/bg_checker", true).toBool();
-
     // Save PNG. It keeps transparency if checker background is not explicitly requested.
+    // The file PNG is reused unless the checker changes pixels.
 
-    if (needChecker)
-        Utils::fillTransparencyWithChecker(screenshot, checkerWidth, checkerHeight, checkerFirstColour, checkerSecondColour);
+    if (options.needChecker)
+        Utils::fillTransparencyWithChecker(screenshot, options.checkerWidth, options.checkerHeight,
+                                           options.checkerFirstColour, options.checkerSecondColour);
 
+    if (options.needChecker || result.png.isEmpty())
     {
-        QByteArray imageData;
-        QBuffer buffer(&imageData);
+        result.png.clear();
+        QBuffer buffer(&result.png);
         if (buffer.open(QIODevice::WriteOnly))
         {
             screenshot.save(&buffer, "PNG", 100);
             buffer.close();
         }
-
-        data->setData("PNG", imageData);
     }
 
     // Save with Qt. On Windows it expands into a whole bunch of formats inside a clipboard,
     // and we can't access them here. Qt doesn't handle transparency, all transparent pixels
     // become black. We fill the background with a checker instead.
 
-    if (settings->getEntryValue("cegui/screenshots/use_qt_setimage", true).toBool())
+    if (options.useQtImage)
     {
-        if (!needChecker)
-            Utils::fillTransparencyWithChecker(screenshot, checkerWidth, checkerHeight, checkerFirstColour, checkerSecondColour);
+        if (!options.needChecker)
+            Utils::fillTransparencyWithChecker(screenshot, options.checkerWidth, options.checkerHeight,
+                                               options.checkerFirstColour, options.checkerSecondColour);
 
-        data->setImageData(screenshot);
+        result.qtImage = screenshot;
     }
 
-    QApplication::clipboard()->setMimeData(data);
+    return result;
+}
+
+// Pixels are read back and encoded asynchronously, the GUI thread only renders the context and
+// puts the result to the clipboard when it is ready
+void LayoutVisualMode::takeScreenshot()
+{
+    if (!scene) return;
+
+    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+
+    ScreenshotOptions options;
+    options.checkerWidth = settings->getEntryValue("cegui/background/checker_width").toInt();
+    options.checkerHeight = settings->getEntryValue("cegui/background/checker_height").toInt();
+    options.checkerFirstColour = settings->getEntryValue("cegui/background/first_colour").value<QColor>();
+    options.checkerSecondColour = settings->getEntryValue("cegui/background/second_colour").value<QColor>();
+    options.needChecker = settings->getEntryValue("cegui/screenshots/bg_checker", true).toBool();
+    options.useQtImage = settings->getEntryValue("cegui/screenshots/use_qt_setimage", true).toBool();
+
+    if (settings->getEntryValue("cegui/screenshots/save", true).toBool())
+    {
+        // TODO: add project subfolder (need name), optional through settings
+        const QDir dir(QDir(QStandardPaths::writableLocation(QStandardPaths::PicturesLocation)).filePath("CEED"));
+        const QString fileName = QString("%1-%2x%3-%4.png")
+                .arg(QFileInfo(getEditor().getFilePath()).baseName())
+                .arg(static_cast<int>(scene->getContextWidth()))
+                .arg(static_cast<int>(scene->getContextHeight()))
+                .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
+
+        dir.mkpath(".");
+        options.filePath = dir.filePath(fileName);
+    }
+
+    const auto afterSaveAction = settings->getEntryValue("cegui/screenshots/after_save_action").toInt();
+
+    // Results are delivered even if the editor is closed in the meantime
+    scene->readCEGUIScreenshot([options, afterSaveAction](const QImage& pixels)
+    {
+        if (pixels.isNull()) return;
+
+        auto watcher = new QFutureWatcher<EncodedScreenshot>(qApp);
+        QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [watcher, options, afterSaveAction]()
+        {
+            const EncodedScreenshot result = watcher->result();
+            watcher->deleteLater();
+
+            if (result.saved)
+            {
+                switch (afterSaveAction)
+                {
+                    // TODO: https://stackoverflow.com/questions/3490336/how-to-reveal-in-finder-or-show-in-explorer-with-qt
+                    case 0: QDesktopServices::openUrl(QUrl::fromLocalFile(QFileInfo(options.filePath).path())); break;
+                    case 1: QDesktopServices::openUrl(QUrl::fromLocalFile(options.filePath)); break;
+                    default: break;
+                }
+            }
+
+            QMimeData* data = new QMimeData();
+            data->setData("PNG", result.png);
+            if (!result.qtImage.isNull()) data->setImageData(result.qtImage);
+            QApplication::clipboard()->setMimeData(data);
+        });
+
+        watcher->setFuture(QtConcurrent::run(encodeScreenshot, pixels, options));
+    });
 }
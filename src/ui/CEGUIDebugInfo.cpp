@@ -3,8 +3,15 @@
 #include "src/cegui/CEGUIManager.h"
 #include "src/cegui/CEGUIUtils.h"
 #include "src/util/Settings.h"
+#include "src/ui/widgets/FrameProfilerWidget.h"
 #include "src/Application.h"
 #include "qtextbrowser.h"
+#include "qheaderview.h"
+#include "qfiledialog.h"
+#include "qmessagebox.h"
+#include "qtimer.h"
+#include "qdatetime.h"
+#include <algorithm>
 
 CEGUIDebugInfo::CEGUIDebugInfo(QWidget *parent) :
     QDialog(parent),
@@ -24,6 +31,19 @@ CEGUIDebugInfo::CEGUIDebugInfo(QWidget *parent) :
 
     ui->logViewArea->setLayout(logViewAreaLayout);
 
+    // Frame times are collected only while this dialog is shown
+    frameProfilerWidget = new FrameProfilerWidget(this);
+    ui->renderingPerformanceLayout->addWidget(frameProfilerWidget, 2, 0, 1, 2);
+
+    frameProfileTimer = new QTimer(this);
+    frameProfileTimer->setInterval(250);
+    connect(frameProfileTimer, &QTimer::timeout, this, &CEGUIDebugInfo::updateFrameProfile);
+
+    // Buffers are allocated and evicted as scenes render, the usage is refreshed along with frame times
+    connect(frameProfileTimer, &QTimer::timeout, this, &CEGUIDebugInfo::updateOffscreenBufferUsage);
+
+    ui->syncTimingsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
     auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
     messageLimit = settings->getEntryValue("global/cegui_debug_info/log_limit").toInt();
 }
@@ -51,28 +71,96 @@ font-size: 10px;\
 </table>\
 </html>");
 
-/*
-//???need at all? it is a per-view data and it has no much significance in an editor,
-//especially when continuous rendering is disabled
-        self.updateFPSTick()
-*/
+    updateSyncTimings();
+    updateOffscreenBufferUsage();
 
     QDialog::show();
 }
 
-/*
-    def updateFPSTick(self):
-        if not self.isVisible():
-            return
+void CEGUIDebugInfo::updateSyncTimings()
+{
+    const auto& timings = CEGUIManager::Instance().getSyncTimings();
+    const auto& records = timings.getRecords();
+
+    if (records.empty())
+        ui->syncTotalLabel->setText("No project resources were loaded yet");
+    else
+        ui->syncTotalLabel->setText(QString("Last synchronisation took %1 ms, %2 records")
+                                    .arg(timings.getTotalTime() / 1000000.0, 0, 'f', 1).arg(records.size()));
+
+    // Sorting would move rows while they are filled
+    ui->syncTimingsTable->setSortingEnabled(false);
+    ui->syncTimingsTable->setRowCount(static_cast<int>(records.size()));
+
+    int row = 0;
+    for (const auto& record : records)
+    {
+        ui->syncTimingsTable->setItem(row, 0, new QTableWidgetItem(CEGUISyncTimings::getStageName(record.stage)));
+        ui->syncTimingsTable->setItem(row, 1, new QTableWidgetItem(record.schemeFile));
+        ui->syncTimingsTable->setItem(row, 2, new QTableWidgetItem(record.fileName));
+
+        // Numeric data makes the column sort by value, not as text
+        auto timeItem = new QTableWidgetItem();
+        timeItem->setData(Qt::DisplayRole, qRound(record.nsec / 1000.0) / 1000.0);
+        ui->syncTimingsTable->setItem(row, 3, timeItem);
+
+        ++row;
+    }
+
+    ui->syncTimingsTable->setSortingEnabled(true);
+}
+
+void CEGUIDebugInfo::updateOffscreenBufferUsage()
+{
+    const auto& manager = CEGUIManager::Instance().getRenderTargetManager();
+    const qint64 budget = manager.getBudget();
+
+    QString text = QString("%1 buffers, %2 MB").arg(manager.getBufferCount()).arg(manager.getUsedBytes() / (1024.0 * 1024.0), 0, 'f', 1);
+    if (budget)
+        text += QString(" of %1 MB").arg(budget / (1024 * 1024));
+
+    ui->offscreenBuffersBox->setText(text);
+}
+
+void CEGUIDebugInfo::on_exportTimingsButton_clicked()
+{
+    const QString fileName = QFileDialog::getSaveFileName(this, "Export resource loading times", "", "JSON files (*.json)");
+    if (fileName.isEmpty()) return;
 
-        lastRenderDelta = self.containerWidget.ceguiInstance.lastRenderTimeDelta
-        if lastRenderDelta <= 0:
-            lastRenderDelta = 1
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly) || file.write(CEGUIManager::Instance().getSyncTimings().toJson().toJson()) < 0)
+        QMessageBox::warning(this, "Export failed", "Can't write resource loading times to " + fileName);
+}
+
+void CEGUIDebugInfo::showEvent(QShowEvent* event)
+{
+    QDialog::showEvent(event);
 
-        self.currentFPSBox.setText("%0.6f" % (1.0 / lastRenderDelta))
+    CEGUIManager::Instance().getFrameProfiler().setEnabled(true);
+    frameProfileTimer->start();
+}
 
-        QtCore.QTimer.singleShot(500, self.updateFPSTick)
-*/
+void CEGUIDebugInfo::hideEvent(QHideEvent* event)
+{
+    frameProfileTimer->stop();
+    CEGUIManager::Instance().getFrameProfiler().setEnabled(false);
+
+    QDialog::hideEvent(event);
+}
+
+// FPS counts paints of all CEGUI views during the last second
+void CEGUIDebugInfo::updateFrameProfile()
+{
+    const qint64 secondAgo = QDateTime::currentMSecsSinceEpoch() - 1000;
+    const auto& history = CEGUIManager::Instance().getFrameProfiler().getHistory();
+    const auto framesInLastSecond = std::count_if(history.begin(), history.end(), [secondAgo](const CEGUIFrameProfiler::Frame& frame)
+    {
+        return frame.endTime > secondAgo;
+    });
+
+    ui->currentFPSBox->setText(QString::number(framesInLastSecond));
+    frameProfilerWidget->update();
+}
 
 void CEGUIDebugInfo::logEvent(const CEGUI::String& message, CEGUI::LoggingLevel level)
 {
@@ -11,6 +11,8 @@ class CEGUIDebugInfo;
 }
 
 class QTextBrowser;
+class QTimer;
+class FrameProfilerWidget;
 
 class CEGUIDebugInfo : public QDialog
 {
@@ -22,10 +24,24 @@ public:
 
     void show();
     void logEvent(const CEGUI::String& message, CEGUI::LoggingLevel level);
+    void updateSyncTimings();
+    void updateOffscreenBufferUsage();
+
+private slots:
+
+    void on_exportTimingsButton_clicked();
 
 private:
+
+    virtual void showEvent(QShowEvent* event) override;
+    virtual void hideEvent(QHideEvent* event) override;
+
+    void updateFrameProfile();
+
     Ui::CEGUIDebugInfo *ui;
     QTextBrowser* logView = nullptr;
+    FrameProfilerWidget* frameProfilerWidget = nullptr;
+    QTimer* frameProfileTimer = nullptr;
 
     QStringList logMessages;
 
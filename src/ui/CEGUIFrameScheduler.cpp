@@ -0,0 +1,103 @@
+#include "src/ui/CEGUIFrameScheduler.h"
+#include "src/ui/CEGUIGraphicsView.h"
+#include "src/util/Settings.h"
+#include "src/util/SettingsEntry.h"
+#include "src/Application.h"
+#include "qevent.h"
+#include <algorithm>
+
+CEGUIFrameScheduler::CEGUIFrameScheduler(QObject* parent)
+    : QObject(parent)
+{
+    _timer.setTimerType(Qt::PreciseTimer);
+    connect(&_timer, &QTimer::timeout, this, &CEGUIFrameScheduler::onTick);
+
+    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+    auto frameRateEntry = settings->getEntry("cegui/rendering/frame_rate");
+    assert(frameRateEntry);
+
+    setFrameRate(frameRateEntry->value().toInt());
+
+    connect(frameRateEntry, &SettingsEntry::valueChanged, [this](const QVariant& newValue)
+    {
+        setFrameRate(newValue.toInt());
+    });
+}
+
+void CEGUIFrameScheduler::addView(CEGUIGraphicsView* view)
+{
+    if (!view || findView(view) != _views.end()) return;
+
+    _views.push_back({ view, view->viewport() });
+
+    // Views are never required to unregister, the connection is dropped if the scheduler dies first
+    connect(view, &QObject::destroyed, this, [this, view]()
+    {
+        removeView(view);
+    });
+
+    view->viewport()->installEventFilter(this);
+
+    if (!_timer.isActive() && isViewShown(view)) _timer.start();
+}
+
+void CEGUIFrameScheduler::removeView(CEGUIGraphicsView* view)
+{
+    auto it = findView(view);
+    if (it == _views.end()) return;
+
+    // May be called from QObject::destroyed of the view, the view itself must not be touched
+    if (it->viewport) it->viewport->removeEventFilter(this);
+    _views.erase(it);
+    disconnect(view, &QObject::destroyed, this, nullptr);
+
+    if (_views.empty()) _timer.stop();
+}
+
+void CEGUIFrameScheduler::setFrameRate(int framesPerSecond)
+{
+    _timer.setInterval(1000 / std::max(1, std::min(framesPerSecond, 1000)));
+}
+
+// CEGUI contents of all shown views are rendered before any of them is painted, with the CEGUI
+// OpenGL context made current once per tick and not twice per view. Painting only blits them.
+void CEGUIFrameScheduler::onTick()
+{
+    bool anyShown = false;
+    for (auto& entry : _views)
+    {
+        auto view = entry.view;
+        if (!isViewShown(view)) continue;
+
+        anyShown = true;
+        view->renderCEGUIOffscreen();
+        view->viewport()->update();
+    }
+
+    // Don't wake the GUI thread for nothing, eventFilter restarts us when some view appears again
+    if (!anyShown) _timer.stop();
+}
+
+// Viewports become visible again through a show event (tab switch, dock reopening) or at least
+// a repaint (window restoring, uncovering), both are delivered before the user sees a stale frame
+bool CEGUIFrameScheduler::eventFilter(QObject* watched, QEvent* event)
+{
+    if (!_timer.isActive() && (event->type() == QEvent::Show || event->type() == QEvent::Paint))
+        _timer.start();
+
+    return QObject::eventFilter(watched, event);
+}
+
+std::vector<CEGUIFrameScheduler::ViewEntry>::iterator CEGUIFrameScheduler::findView(const CEGUIGraphicsView* view)
+{
+    return std::find_if(_views.begin(), _views.end(), [view](const ViewEntry& entry) { return entry.view == view; });
+}
+
+// Pages of inactive tabs and closed docks are invisible, obscured or collapsed views have an empty visible region
+bool CEGUIFrameScheduler::isViewShown(const CEGUIGraphicsView* view)
+{
+    if (!view->isVisible() || view->window()->isMinimized()) return false;
+
+    auto vp = view->viewport();
+    return vp && !vp->visibleRegion().isEmpty();
+}
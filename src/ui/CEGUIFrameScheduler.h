@@ -0,0 +1,49 @@
+#ifndef CEGUIFRAMESCHEDULER_H
+#define CEGUIFRAMESCHEDULER_H
+
+#include "qobject.h"
+#include "qtimer.h"
+#include "qpointer.h"
+#include "qwidget.h"
+#include <vector>
+
+// Drives continuous rendering of all CEGUI views with one timer. Each tick requests a repaint of
+// every registered view the user can actually see, hidden and minimized views are skipped. The timer
+// stops while none of the views is shown and restarts when the viewport of any of them is shown or
+// painted again, which happens on tab switch, dock reopening and window restoring. Qt merges
+// repeated update requests, so a view is painted at most once per tick whatever else asks for it.
+// CEGUI contents of views are rendered in the tick itself, one after another in the CEGUI context.
+
+class CEGUIGraphicsView;
+
+class CEGUIFrameScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit CEGUIFrameScheduler(QObject* parent = nullptr);
+
+    void addView(CEGUIGraphicsView* view);
+    void removeView(CEGUIGraphicsView* view);
+    void setFrameRate(int framesPerSecond);
+
+protected:
+
+    struct ViewEntry
+    {
+        CEGUIGraphicsView* view;
+        QPointer<QWidget> viewport; // Pooled viewports outlive views, our event filter must not stay on them
+    };
+
+    virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+    void onTick();
+    std::vector<ViewEntry>::iterator findView(const CEGUIGraphicsView* view);
+    static bool isViewShown(const CEGUIGraphicsView* view);
+
+    std::vector<ViewEntry> _views;
+    QTimer _timer;
+};
+
+#endif // CEGUIFRAMESCHEDULER_H
@@ -1,15 +1,18 @@
 #include "src/ui/CEGUIGraphicsScene.h"
 #include "src/cegui/CEGUIManager.h"
 #include "src/cegui/CEGUIProject.h"
+#include "src/cegui/CEGUIPixelReadback.h"
 #include <CEGUI/RendererModules/OpenGL/RendererBase.h>
 #include <CEGUI/RendererModules/OpenGL/ViewportTarget.h>
 #include <CEGUI/System.h>
 #include <CEGUI/GUIContext.h>
 #include <qdatetime.h>
+#include <qelapsedtimer.h>
 #include <qgraphicsitem.h>
 #include <qopenglcontext.h>
 #include <qopenglfunctions.h>
 #include <qopenglframebufferobject.h>
+#include <qtimer.h>
 
 static void validateResolution(float& width, float& height)
 {
@@ -48,12 +51,11 @@ CEGUIGraphicsScene::CEGUIGraphicsScene(QObject* parent, float width, float heigh
 
 CEGUIGraphicsScene::~CEGUIGraphicsScene()
 {
-    if (_fbo)
-    {
-        CEGUIManager::Instance().makeOpenGLContextCurrent();
-        delete _fbo;
-        CEGUIManager::Instance().doneOpenGLContextCurrent();
-    }
+    CEGUIManager::Instance().makeOpenGLContextCurrent();
+    releaseOffscreenBuffer();
+    _drawGPUTimer.destroy();
+    _screenshotReadback.reset();
+    CEGUIManager::Instance().doneOpenGLContextCurrent();
 
     if (ceguiContext)
     {
@@ -84,11 +86,19 @@ void CEGUIGraphicsScene::setCEGUIDisplaySize(float width, float height)
     area.setSize(newSize);
     renderTarget.setArea(area);
 
+    markCEGUIDirty();
     update();
 }
 
-// Renders CEGUI context to texture using FBO. All shared contexts can then access FBO texture.
-void CEGUIGraphicsScene::drawCEGUIContextOffscreen()
+// CEGUI marks the context dirty whenever any of its windows is invalidated, e.g. by a property
+// change or by an animation step during the time pulse
+bool CEGUIGraphicsScene::isCEGUIDirty() const
+{
+    return _ceguiDirty || !_fbo || (ceguiContext && ceguiContext->isDirty());
+}
+
+// Injects the time passed since the last update all at once. Needs no OpenGL context.
+void CEGUIGraphicsScene::updateCEGUIContext()
 {
     if (!ceguiContext) return;
 
@@ -96,25 +106,89 @@ void CEGUIGraphicsScene::drawCEGUIContextOffscreen()
     lastDelta = currTime - timeOfLastRender;
     timeOfLastRender = currTime;
 
-    // Inject the time passed since the last render all at once
+    QElapsedTimer timer;
+    timer.start();
+
     CEGUI::System::getSingleton().injectTimePulse(lastDelta);
     ceguiContext->injectTimePulse(lastDelta);
 
-    drawCEGUIContextInternal();
+    CEGUIManager::Instance().getFrameProfiler().addCPUTime(CEGUIFrameProfiler::Stage::TimePulse, timer.nsecsElapsed());
+}
+
+// If nothing changed since the last render the FBO is left as is and can be blitted again.
+// visibleRect is a part of the scene shown by the view, rendering is postponed while it doesn't
+// intersect the context. The context is always rendered as a whole: CEGUI computes scissor rects
+// of its geometry from the render target size only, so rendering tiles with an offset viewport
+// would break clipping of every widget that isn't at the tile origin.
+bool CEGUIGraphicsScene::needsCEGUIRender(const QRectF& visibleRect) const
+{
+    if (!ceguiContext || !isCEGUIDirty()) return false;
+
+    // The FBO stays dirty and is rendered as soon as any part of the context is scrolled into view
+    return !_fbo || !visibleRect.isValid() ||
+            visibleRect.intersects(QRectF(0.0, 0.0, static_cast<qreal>(contextWidth), static_cast<qreal>(contextHeight)));
+}
+
+// Renders the context and starts reading its pixels back without waiting for the GPU. onReady is
+// called from the event loop when pixels arrive, see CEGUIPixelReadback::finish for their layout.
+// Returns false if nothing can be read or the previous screenshot of this scene is still pending.
+bool CEGUIGraphicsScene::readCEGUIScreenshot(std::function<void(const QImage&)> onReady)
+{
+    if (!ceguiContext || _screenshotReadback) return false;
+
+    drawCEGUIContextOffscreen();
+
+    std::unique_ptr<CEGUIPixelReadback> readback(new CEGUIPixelReadback());
+    _fbo->bind();
+    const bool started = readback->start(_fbo->width(), _fbo->height());
+    _fbo->release();
+
+    if (!started) readback.reset();
+
     CEGUIManager::Instance().doneOpenGLContextCurrent();
+
+    if (!readback) return false;
+
+    _screenshotReadback = std::move(readback);
+    _onScreenshotReady = std::move(onReady);
+    QTimer::singleShot(0, this, [this]() { pollCEGUIScreenshot(); });
+
+    return true;
 }
 
-QImage CEGUIGraphicsScene::getCEGUIScreenshot()
+void CEGUIGraphicsScene::pollCEGUIScreenshot()
 {
-    if (!ceguiContext) return QImage();
+    if (!_screenshotReadback) return;
 
-    drawCEGUIContextInternal();
+    CEGUIManager::Instance().makeOpenGLContextCurrent();
 
-    QImage result = _fbo->toImage();
+    if (!_screenshotReadback->isReady())
+    {
+        CEGUIManager::Instance().doneOpenGLContextCurrent();
+        QTimer::singleShot(1, this, [this]() { pollCEGUIScreenshot(); });
+        return;
+    }
+
+    const QImage result = _screenshotReadback->finish();
+    _screenshotReadback.reset();
 
     CEGUIManager::Instance().doneOpenGLContextCurrent();
 
-    return result;
+    // The callback may request the next screenshot
+    auto onReady = std::move(_onScreenshotReady);
+    _onScreenshotReady = nullptr;
+    if (onReady) onReady(result);
+}
+
+// Must be called with the CEGUI OpenGL context current. The next render creates a new buffer.
+void CEGUIGraphicsScene::releaseOffscreenBuffer()
+{
+    if (!_fbo) return;
+
+    CEGUIManager::Instance().getRenderTargetManager().onBufferReleased(this);
+
+    delete _fbo;
+    _fbo = nullptr;
 }
 
 QList<QGraphicsItem*> CEGUIGraphicsScene::topLevelItems() const
@@ -129,8 +203,10 @@ QList<QGraphicsItem*> CEGUIGraphicsScene::topLevelItems() const
     return ret;
 }
 
-// NB: it doesn't disable context, callers may need it for further operations
-void CEGUIGraphicsScene::drawCEGUIContextInternal()
+// Renders CEGUI context to texture using FBO. All shared contexts can then access FBO texture.
+// NB: it doesn't disable context, callers may need it for further operations, and several scenes
+// can be rendered in a row with the context made current only once.
+void CEGUIGraphicsScene::drawCEGUIContextOffscreen()
 {
     if (!ceguiContext) return;
 
@@ -147,7 +223,12 @@ void CEGUIGraphicsScene::drawCEGUIContextInternal()
         _fbo = new QOpenGLFramebufferObject(w, h);
     }
 
+    auto& profiler = CEGUIManager::Instance().getFrameProfiler();
+    QElapsedTimer timer;
+    timer.start();
+
     _fbo->bind();
+    _drawGPUTimer.begin(profiler);
 
     auto gl = QOpenGLContext::currentContext()->functions();
     gl->glClearColor(0.f, 0.f, 0.f, 0.f);
@@ -158,5 +239,13 @@ void CEGUIGraphicsScene::drawCEGUIContextInternal()
     ceguiContext->draw();
     renderer->endRendering();
 
+    _drawGPUTimer.end();
     _fbo->release();
+
+    profiler.addCPUTime(CEGUIFrameProfiler::Stage::CEGUIDraw, timer.nsecsElapsed());
+
+    _ceguiDirty = false;
+
+    // May release buffers of other scenes, ours is kept because it is about to be shown
+    CEGUIManager::Instance().getRenderTargetManager().onBufferRendered(this, static_cast<qint64>(w) * h * 4);
 }
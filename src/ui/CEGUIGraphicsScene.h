@@ -2,6 +2,9 @@
 #define CEGUIGRAPHICSSCENE_H
 
 #include "qgraphicsscene.h"
+#include "src/cegui/CEGUIFrameProfiler.h"
+#include <functional>
+#include <memory>
 
 // A scene that draws CEGUI as it's background. Subclass this to be able to show Qt graphic
 // items and widgets on top of the embedded CEGUI widget! Interaction is also supported.
@@ -12,6 +15,7 @@ namespace CEGUI
 }
 
 class QOpenGLFramebufferObject;
+class CEGUIPixelReadback;
 
 class CEGUIGraphicsScene : public QGraphicsScene
 {
@@ -21,8 +25,12 @@ public:
     virtual ~CEGUIGraphicsScene() override;
 
     virtual void setCEGUIDisplaySize(float width, float height);
+    void updateCEGUIContext();
+    bool needsCEGUIRender(const QRectF& visibleRect = QRectF()) const;
     void drawCEGUIContextOffscreen();
-    QImage getCEGUIScreenshot();
+    bool readCEGUIScreenshot(std::function<void(const QImage&)> onReady);
+    void markCEGUIDirty() { _ceguiDirty = true; }
+    bool isCEGUIDirty() const;
 
     qint64 getLastDeltaMSec() const { return lastDelta; }
     CEGUI::GUIContext* getCEGUIContext() const { return ceguiContext; }
@@ -31,13 +39,18 @@ public:
     QList<QGraphicsItem*> topLevelItems() const;
 
     QOpenGLFramebufferObject* getOffscreenBuffer() const { return _fbo; }
+    void releaseOffscreenBuffer();
 
 protected:
 
-    void drawCEGUIContextInternal();
+    void pollCEGUIScreenshot();
 
     CEGUI::GUIContext* ceguiContext = nullptr;
     QOpenGLFramebufferObject* _fbo = nullptr;
+    bool _ceguiDirty = true; // FBO content is outdated even if CEGUI itself reports no changes
+    CEGUIFrameProfiler::GPUTimer _drawGPUTimer { CEGUIFrameProfiler::Stage::CEGUIDraw };
+    std::unique_ptr<CEGUIPixelReadback> _screenshotReadback;
+    std::function<void(const QImage&)> _onScreenshotReady;
 
     qint64 lastDelta = 0;
     qint64 timeOfLastRender;
@@ -1,8 +1,12 @@
 #include "src/ui/CEGUIGraphicsView.h"
 #include "src/ui/CEGUIGraphicsScene.h"
+#include "src/ui/CEGUIFrameScheduler.h"
+#include "src/ui/MainWindow.h"
 #include "src/util/Settings.h"
 #include "src/util/Utils.h"
+#include "src/util/SettingsHandle.h"
 #include "src/cegui/CEGUIUtils.h"
+#include "src/cegui/CEGUIManager.h"
 #include "src/Application.h"
 #include <CEGUI/System.h>
 #include <CEGUI/WindowManager.h>
@@ -14,8 +18,12 @@
 #include "qopengltextureblitter.h"
 #include "qopenglcontext.h"
 #include "qopenglfunctions.h"
-#include "qtimer.h"
 #include "qevent.h"
+#include "qelapsedtimer.h"
+#include <algorithm>
+
+static SettingsHandle<int> interactionInterval("cegui/rendering/interaction_interval");
+static SettingsHandle<int> interactionIdleDelay("cegui/rendering/interaction_idle_delay");
 
 CEGUIGraphicsView::CEGUIGraphicsView(QWidget *parent) :
     ResizableGraphicsView(parent)
@@ -41,6 +49,15 @@ CEGUIGraphicsView::CEGUIGraphicsView(QWidget *parent) :
     checkerboardBrush = Utils::getCheckerboardBrush(checkerWidth, checkerHeight, checkerFirstColour, checkerSecondColour);
 
     blitter = new QOpenGLTextureBlitter();
+
+    // Changes skipped during an interaction are rendered when it ends or when the interval passes
+    _interactionEndTimer.setSingleShot(true);
+    connect(&_interactionEndTimer, &QTimer::timeout, viewport(), static_cast<void(QWidget::*)()>(&QWidget::update));
+    _throttledRenderTimer.setSingleShot(true);
+    connect(&_throttledRenderTimer, &QTimer::timeout, viewport(), static_cast<void(QWidget::*)()>(&QWidget::update));
+
+    if (continuousRendering)
+        qobject_cast<Application*>(qApp)->getMainWindow()->getFrameScheduler()->addView(this);
 }
 
 CEGUIGraphicsView::~CEGUIGraphicsView()
@@ -50,12 +67,26 @@ CEGUIGraphicsView::~CEGUIGraphicsView()
     auto vp = static_cast<QOpenGLWidget*>(viewport());
     vp->makeCurrent();
     delete blitter;
+    _blitGPUTimer.destroy();
     vp->doneCurrent();
 
     // FIXME QTBUG: Qt 5.13.0 text rendering in OpenGL breaks on QOpenGLWidget delete
     qobject_cast<Application*>(qApp)->getMainWindow()->freeOpenGLWidget(viewport());
 }
 
+void CEGUIGraphicsView::setContinuousRendering(bool on)
+{
+    if (continuousRendering == on) return;
+
+    continuousRendering = on;
+
+    auto frameScheduler = qobject_cast<Application*>(qApp)->getMainWindow()->getFrameScheduler();
+    if (continuousRendering)
+        frameScheduler->addView(this);
+    else
+        frameScheduler->removeView(this);
+}
+
 // FIXME: works only for the current scene because we can't catch scene change event
 // (Or maybe we can but I have no internet right now to check it)
 void CEGUIGraphicsView::injectInput(bool inject)
@@ -89,6 +120,10 @@ void CEGUIGraphicsView::drawBackground(QPainter* painter, const QRectF& rect)
     auto ceguiScene = static_cast<CEGUIGraphicsScene*>(scene());
     if (!ceguiScene) return;
 
+    auto& profiler = CEGUIManager::Instance().getFrameProfiler();
+    QElapsedTimer backgroundTimer;
+    backgroundTimer.start();
+
     const int contextWidth = static_cast<int>(ceguiScene->getContextWidth());
     const int contextHeight = static_cast<int>(ceguiScene->getContextHeight());
     QRect viewportRect(0, 0, contextWidth, contextHeight);
@@ -96,20 +131,17 @@ void CEGUIGraphicsView::drawBackground(QPainter* painter, const QRectF& rect)
     painter->setBrush(checkerboardBrush);
     painter->drawRect(viewportRect);
 
-    // Store view's OpenGL context
-    QOpenGLContext* currContext = QOpenGLContext::currentContext();
-    QSurface* currSurface = currContext->surface();
-    currContext->doneCurrent();
-
-    // The main part of CEGUI rendering. Note that it is rendered in an OpenGL context
-    // where its resources are created, since some of them aren't shareable (like VAOs).
+    // CEGUI is rendered before painting starts, in paintEvent or by the frame scheduler, so that
+    // our OpenGL context stays current all the paint long. CEGUI must be rendered in an OpenGL context
+    // where its resources are created, since some of them aren't shareable (like VAOs and FBOs).
     // Resulting texture is shared instead and is blitted to screen in view's context.
-    ceguiScene->drawCEGUIContextOffscreen();
+    QOpenGLContext* currContext = QOpenGLContext::currentContext();
 
-    // Restore view's OpenGL context
-    currContext->makeCurrent(currSurface);
+    QElapsedTimer timer;
+    timer.start();
 
     painter->beginNativePainting();
+    _blitGPUTimer.begin(profiler);
 
     // Restore parameters possibly affected by CEGUI renderer and prepare to blitting
     auto gl = currContext->functions();
@@ -128,31 +160,79 @@ void CEGUIGraphicsView::drawBackground(QPainter* painter, const QRectF& rect)
         blitter->release();
     }
 
+    _blitGPUTimer.end();
     painter->endNativePainting();
 
+    profiler.addCPUTime(CEGUIFrameProfiler::Stage::Blit, timer.nsecsElapsed());
+
+    timer.start();
     CEGUI::WindowManager::getSingleton().cleanDeadPool();
+    profiler.addCPUTime(CEGUIFrameProfiler::Stage::CleanDeadPool, timer.nsecsElapsed());
 
-    if (continuousRendering)
+    _backgroundTime = backgroundTimer.nsecsElapsed();
+}
+
+// Brings the offscreen CEGUI content up to date for the coming paint. Time is injected only once
+// per paint, so the scene rendered ahead is not rendered again unless it changed in the meantime.
+// Returns true if it rendered, the CEGUI OpenGL context is left current then, so that the frame
+// scheduler can render all views in a row with a single context switch.
+bool CEGUIGraphicsView::renderCEGUIOffscreen()
+{
+    auto ceguiScene = static_cast<CEGUIGraphicsScene*>(scene());
+    if (!ceguiScene) return false;
+
+    if (!_timePulseInjected)
+    {
+        ceguiScene->updateCEGUIContext();
+        _timePulseInjected = true;
+    }
+
+    if (!ceguiScene->needsCEGUIRender(mapToScene(viewport()->rect()).boundingRect())) return false;
+
+    // During an interaction the last rendered content is shown until the interval passes. The scene
+    // stays dirty, so skipped changes are never lost.
+    const int interval = std::max(0, interactionInterval.get());
+    if (_interactionEndTimer.isActive() && _lastRenderTime.isValid() && _lastRenderTime.elapsed() < interval)
     {
-        constexpr float desiredFPS = 60.f;
-        constexpr float frameTimeMsec = (desiredFPS <= 0.f) ? 0.f : (1000.0f / desiredFPS);
-
-        const float lastDeltaMSec = static_cast<float>(ceguiScene->getLastDeltaMSec()); //???per-view?
-        const qint64 msecLeft = std::max(static_cast<qint64>(0), static_cast<qint64>(frameTimeMsec - lastDeltaMSec));
-
-        // Direct call to update() from inside here doesn't seem to work, so we schedule a
-        // timer signal even if the time of the next frame has come.
-        QTimer::singleShot(msecLeft, [this]()
-        {
-            update();
-            if (scene())
-                scene()->update();
-        });
+        if (!_throttledRenderTimer.isActive())
+            _throttledRenderTimer.start(static_cast<int>(interval - _lastRenderTime.elapsed()));
+        return false;
     }
+
+    ceguiScene->drawCEGUIContextOffscreen();
+    _lastRenderTime.start();
+    return true;
+}
+
+// Dragging with any mouse button (moving or resizing widgets, panning) or turning the wheel (zooming).
+// Views passing input to CEGUI are never throttled, there the user interacts with CEGUI itself.
+void CEGUIGraphicsView::onInteraction()
+{
+    if (interactionInterval.get() > 0 && !_injectInput) _interactionEndTimer.start(std::max(0, interactionIdleDelay.get()));
+}
+
+// Qt paints the background first and then scene items, the rest of the paint is attributed to items
+void CEGUIGraphicsView::paintEvent(QPaintEvent* event)
+{
+    // Before the painter makes the viewport context current, so there is no switching back and forth
+    renderCEGUIOffscreen();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    _backgroundTime = 0;
+    ResizableGraphicsView::paintEvent(event);
+    _timePulseInjected = false;
+
+    auto& profiler = CEGUIManager::Instance().getFrameProfiler();
+    profiler.addCPUTime(CEGUIFrameProfiler::Stage::SceneItems, std::max(static_cast<qint64>(0), timer.nsecsElapsed() - _backgroundTime));
+    profiler.endFrame();
 }
 
 void CEGUIGraphicsView::wheelEvent(QWheelEvent* event)
 {
+    onInteraction();
+
     bool handled = false;
 
     if (_injectInput && ceguiInput)
@@ -165,6 +245,8 @@ void CEGUIGraphicsView::wheelEvent(QWheelEvent* event)
 
 void CEGUIGraphicsView::mouseMoveEvent(QMouseEvent* event)
 {
+    if (event->buttons() != Qt::NoButton) onInteraction();
+
     bool handled = false;
 
     QPointF point = mapToScene(event->pos());
@@ -2,6 +2,9 @@
 #define CEGUIGRAPHICSVIEW_H
 
 #include "src/ui/ResizableGraphicsView.h"
+#include "src/cegui/CEGUIFrameProfiler.h"
+#include "qelapsedtimer.h"
+#include "qtimer.h"
 
 // This is a final class, not suitable for subclassing. This views given scene using
 // QOpenGLWidget. It's designed to work with CEGUIGraphicsScene derived classes.
@@ -23,7 +26,8 @@ public:
     virtual ~CEGUIGraphicsView() override;
 
     void injectInput(bool inject);
-    void setContinuousRendering(bool on) { continuousRendering = on; }
+    void setContinuousRendering(bool on);
+    bool renderCEGUIOffscreen();
 
     virtual void drawBackground(QPainter* painter, const QRectF& rect) override;
 
@@ -33,6 +37,7 @@ signals:
 
 private:
 
+    virtual void paintEvent(QPaintEvent* event) override;
     virtual void wheelEvent(QWheelEvent *event) override;
     virtual void mouseMoveEvent(QMouseEvent* event) override;
     virtual void mousePressEvent(QMouseEvent* event) override;
@@ -40,13 +45,23 @@ private:
     virtual void keyPressEvent(QKeyEvent* event) override;
     virtual void keyReleaseEvent(QKeyEvent* event) override;
 
+    void onInteraction();
+
     QOpenGLTextureBlitter* blitter = nullptr;
+    CEGUIFrameProfiler::GPUTimer _blitGPUTimer { CEGUIFrameProfiler::Stage::Blit };
+    qint64 _backgroundTime = 0; // Of the current paint, everything else is scene items
+    bool _timePulseInjected = false; // For the coming paint
+
+    // CEGUI render throttling while the user drags, zooms or pans
+    QTimer _interactionEndTimer;
+    QTimer _throttledRenderTimer;
+    QElapsedTimer _lastRenderTime;
     QBrush checkerboardBrush;
 
     CEGUI::InputAggregator* ceguiInput = nullptr;
     bool _injectInput = false;
 
-    // if true, we render always (possibly capped to some FPS) - suitable for live preview
+    // if true, we render always at the frame rate of the shared scheduler - suitable for live preview
     // if false, we render only when update() is called - suitable for visual editing
     bool continuousRendering = true;
 };
@@ -10,16 +10,24 @@
 #include "qsettings.h"
 #include "qevent.h"
 #include "qundostack.h"
+#include "qprogressbar.h"
+#include "qstatusbar.h"
+#include "qinputdialog.h"
+#include "qprogressdialog.h"
+#include "qdiriterator.h"
 #include "src/Application.h"
 #include "src/util/Settings.h"
 #include "src/util/SettingsEntry.h"
 #include "src/util/RecentlyUsed.h"
+#include "src/util/Utils.h"
 #include "src/cegui/CEGUIManager.h"
 #include "src/cegui/CEGUIProject.h"
+#include "src/cegui/CEGUIProjectSyncJob.h"
 #include "src/editors/NoEditor.h"
 #include "src/editors/TextEditor.h"
 #include "src/editors/BitmapEditor.h"
 #include "src/editors/layout/LayoutEditor.h"
+#include "src/editors/layout/LayoutScreenshotExporter.h"
 #include "src/editors/imageset/ImagesetEditor.h"
 #include "src/editors/looknfeel/LookNFeelEditor.h"
 #include "src/editors/anim/AnimationEditor.h"
@@ -32,6 +40,7 @@
 #include "src/ui/ProjectManager.h"
 #include "src/ui/FileSystemBrowser.h"
 #include "src/ui/UndoViewer.h"
+#include "src/ui/CEGUIFrameScheduler.h"
 #include "QtnProperty/PropertyWidget.h"
 
 // FIXME QTBUG: Qt 5.13.0 text rendering in OpenGL breaks on QOpenGLWidget delete
@@ -42,6 +51,7 @@ MainWindow::MainWindow(QWidget *parent) :
     ui(new Ui::MainWindow)
 {
     settingsDialog = new SettingsDialog(this);
+    frameScheduler = new CEGUIFrameScheduler(this);
 
     // Register factories
 
@@ -102,6 +112,22 @@ MainWindow::MainWindow(QWidget *parent) :
 
     ui->actionStatusbar->setChecked(statusBar()->isVisible());
 
+    // Project resources are loaded in background, their progress is shown in the status bar
+    syncProgressBar = new QProgressBar(this);
+    syncProgressBar->setMaximumWidth(200);
+    syncProgressBar->setVisible(false);
+    statusBar()->addPermanentWidget(syncProgressBar);
+
+    syncCancelButton = new QToolButton(this);
+    syncCancelButton->setText("Cancel");
+    syncCancelButton->setToolTip("Cancel loading of project resources");
+    syncCancelButton->setVisible(false);
+    connect(syncCancelButton, &QToolButton::clicked, []()
+    {
+        CEGUIManager::Instance().cancelSync();
+    });
+    statusBar()->addPermanentWidget(syncCancelButton);
+
     setupToolbars();
 
     // Setup dynamic menus
@@ -370,6 +396,8 @@ void MainWindow::updateProjectDependentUI(CEGUIProject* newProject)
         // nasty phenomena
         assert(closeAllTabsRequiringProject());
 
+        filesToOpenAfterSync.clear();
+
         fsBrowser->setDirectory(QDir::homePath());
 
         setWindowTitle(_title);
@@ -381,6 +409,7 @@ void MainWindow::updateProjectDependentUI(CEGUIProject* newProject)
     ui->actionCloseProject->setEnabled(isProjectLoaded);
     ui->actionProjectSettings->setEnabled(isProjectLoaded);
     ui->actionReloadResources->setEnabled(isProjectLoaded);
+    ui->actionExportLayoutScreenshots->setEnabled(isProjectLoaded);
 }
 
 bool MainWindow::confirmProjectClosing(bool onlyModified)
@@ -436,6 +465,7 @@ void MainWindow::loadProject(const QString& path)
 
     CEGUIManager::Instance().loadProject(path);
     updateProjectDependentUI(CEGUIManager::Instance().getCurrentProject());
+    watchProjectSync();
 }
 
 void MainWindow::on_actionNewProject_triggered()
@@ -476,6 +506,11 @@ void MainWindow::on_actionProjectSettings_triggered()
 {
     if (!CEGUIManager::Instance().isProjectLoaded()) return;
 
+    // Files waiting for the running synchronisation will wait for the new one
+    const QStringList queuedFiles = filesToOpenAfterSync;
+    CEGUIManager::Instance().cancelSync();
+    filesToOpenAfterSync = queuedFiles;
+
     // Since we are effectively unloading the project and potentially nuking resources of it
     // we should definitely unload all tabs that rely on it to prevent segfaults and other
     // nasty phenomena
@@ -493,6 +528,7 @@ void MainWindow::on_actionProjectSettings_triggered()
     {
         dialog.apply(*CEGUIManager::Instance().getCurrentProject());
         CEGUIManager::Instance().syncProjectToCEGUIInstance();
+        watchProjectSync();
     }
 }
 
@@ -794,7 +830,8 @@ void MainWindow::closeEditorTab(EditorBase* editor)
 // Attempts to close all tabs that require a project opened.
 // This is usually done when project settings are altered and CEGUI instance has to be reloaded
 // or when project is being closed and we can no longer rely on resource availability.
-bool MainWindow::closeAllTabsRequiringProject()
+// When forced, tabs can't stay opened, the user may only choose to save or to discard changes.
+bool MainWindow::closeAllTabsRequiringProject(bool force)
 {
     int i = 0;
     while (i < ui->tabs->count())
@@ -802,6 +839,26 @@ bool MainWindow::closeAllTabsRequiringProject()
         auto editor = getEditorForTab(i);
         if (editor->requiresProject())
         {
+            if (force)
+            {
+                while (editor->hasChanges())
+                {
+                    auto result = QMessageBox::question(this,
+                                                        "Unsaved changes!",
+                                                        tr("'%1' must be closed because project resources are unloaded. "
+                                                           "Do you want to save its changes? "
+                                                           "(Pressing Discard will discard the changes!)").arg(editor->getFilePath()),
+                                                        QMessageBox::Save | QMessageBox::Discard,
+                                                        QMessageBox::Save);
+
+                    // Asked again if saving fails
+                    if (result != QMessageBox::Save || editor->save()) break;
+                }
+
+                closeEditorTab(editor);
+                continue;
+            }
+
             // If the method returns False user pressed Cancel so in that case
             // we cancel the entire operation
             if (!on_tabs_tabCloseRequested(i)) return false;
@@ -925,6 +982,13 @@ EditorBasePtr MainWindow::createEditorForFile(const QString& absolutePath)
                     ret.reset(new NoEditor(absolutePath,
                         "Opening this file requires you to have a project opened!"));
                 }
+                else if (CEGUIManager::Instance().isSyncInProgress() && factory->requiresProject())
+                {
+                    ret.reset(new NoEditor(absolutePath,
+                        "Project resources are being loaded. This file will be opened as soon as they are ready."));
+                    if (!filesToOpenAfterSync.contains(absolutePath))
+                        filesToOpenAfterSync.append(absolutePath);
+                }
                 else
                 {
                     ret = factory->create(absolutePath);
@@ -1192,38 +1256,224 @@ void MainWindow::on_actionReloadResources_triggered()
     // we should definitely unload all tabs that rely on it to prevent segfaults and other
     // nasty phenomena
 
+    // Files waiting for the running synchronisation will wait for the new one
+    QStringList filePathsToLoad = filesToOpenAfterSync;
+    CEGUIManager::Instance().cancelSync();
+
+    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+    const bool incremental = settings->getEntryValue("cegui/resources/incremental_reload").toBool() &&
+            CEGUIManager::Instance().canSyncIncrementally();
+
+    // Incremental reload leaves resources of unchanged files intact, so layouts which depend on
+    // none of the changed files can stay opened. Anything we can't be sure about is reopened.
+    auto& dependencyGraph = CEGUIManager::Instance().getDependencyGraph();
+    const bool targeted = incremental && dependencyGraph.isReady();
+    QStringList changedFiles, affectedFiles;
+    if (targeted)
+    {
+        // Resources are rebuilt by what the synchronisation finds outdated, the graph's own snapshot
+        // compares timestamps only and could miss some. It adds changes of files the sync doesn't track.
+        changedFiles = CEGUIManager::Instance().getOutdatedResourceFiles();
+        for (const auto& filePath : dependencyGraph.getChangedFiles(*CEGUIManager::Instance().getCurrentProject()))
+            if (!changedFiles.contains(filePath))
+                changedFiles.append(filePath);
+        affectedFiles = dependencyGraph.getAffectedFiles(changedFiles);
+    }
+
+    auto mustBeReopened = [&](const EditorBase& editor)
+    {
+        if (!targeted || !dynamic_cast<const LayoutEditor*>(&editor) || editor.hasChanges()) return true;
+
+        const QString filePath = QDir::cleanPath(editor.getFilePath());
+        return !dependencyGraph.isKnownFile(filePath) || changedFiles.contains(filePath) || affectedFiles.contains(filePath);
+    };
+
     // We will remember previously opened tabs requiring a project so that we can load them up after we are done
-    QStringList filePathsToLoad;
+    QStringList filePathsToClose;
     int i = 0;
     while (i < ui->tabs->count())
     {
         auto editor = getEditorForTab(i);
-        if (editor->requiresProject())
-            filePathsToLoad.append(editor->getFilePath());
+        if (editor->requiresProject() && mustBeReopened(*editor))
+            filePathsToClose.append(editor->getFilePath());
 
         ++i;
     }
 
     QString currEditorFilePath = currentEditor ? currentEditor->getFilePath() : "";
 
-    if (!closeAllTabsRequiringProject())
+    i = 0;
+    while (i < ui->tabs->count())
     {
-        QMessageBox::information(this,
-                                 "Project dependent tabs still open!",
-                                 "You can't reload project's resources while having tabs that "
-                                 "depend on the project and its resources opened!");
+        auto editor = getEditorForTab(i);
+        if (editor->requiresProject() && filePathsToClose.contains(editor->getFilePath()))
+        {
+            // If the method returns False user pressed Cancel so in that case
+            // we cancel the entire operation
+            if (!on_tabs_tabCloseRequested(i))
+            {
+                QMessageBox::information(this,
+                                         "Project dependent tabs still open!",
+                                         "You can't reload project's resources while having tabs that "
+                                         "depend on the project and its resources opened!");
+                return;
+            }
+
+            continue;
+        }
+
+        ++i;
+    }
+
+    filePathsToLoad.append(filePathsToClose);
+
+    // Previously active editor to be loaded last, this makes it active again
+    if (filePathsToClose.contains(currEditorFilePath))
+        filePathsToLoad.append(currEditorFilePath);
+
+    // Previously loaded tabs requiring a project opened are reopened when resources are ready
+    filesToOpenAfterSync = filePathsToLoad;
+
+    CEGUIManager::Instance().syncProjectToCEGUIInstance(incremental);
+    watchProjectSync();
+}
+
+// Saves screenshots of all project layouts at each of the chosen resolutions, e.g. for reviewing
+// changes in resources. Saved files are layouts, not their unsaved state in open editors.
+void MainWindow::on_actionExportLayoutScreenshots_triggered()
+{
+    auto project = CEGUIManager::Instance().getCurrentProject();
+    if (!project) return;
+
+    if (CEGUIManager::Instance().isSyncInProgress())
+    {
+        QMessageBox::information(this, "Export layout screenshots", "Wait until project resources are loaded.");
         return;
     }
 
-    CEGUIManager::Instance().syncProjectToCEGUIInstance();
+    const QString layoutsDirectory = project->getAbsolutePathOf(project->layoutsPath);
+    QStringList layoutFilePaths;
+    QDirIterator it(layoutsDirectory, { "*.layout" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        layoutFilePaths.append(QDir::cleanPath(it.next()));
 
-    // Load previously loaded tabs requiring a project opened
-    for (auto& filePath : filePathsToLoad)
-        openEditorTab(filePath);
+    if (layoutFilePaths.isEmpty())
+    {
+        QMessageBox::information(this, "Export layout screenshots", "There are no layouts in '" + layoutsDirectory + "'.");
+        return;
+    }
 
-    // Previously active editor to be loaded last, this makes it active again
-    if (!currEditorFilePath.isEmpty())
-        openEditorTab(currEditorFilePath);
+    layoutFilePaths.sort();
+
+    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
+    bool ok = false;
+    const QString resolutionsStr = QInputDialog::getText(this, "Export layout screenshots",
+                                                         "Resolutions (e.g. 1280x720, 1920x1080):", QLineEdit::Normal,
+                                                         settings->getEntryValue("layout/preview/resolutions").toString(), &ok);
+    if (!ok) return;
+
+    const auto resolutions = Utils::parseResolutions(resolutionsStr);
+    if (resolutions.empty())
+    {
+        QMessageBox::warning(this, "Export layout screenshots", "No valid resolutions entered.");
+        return;
+    }
+
+    const QString outputDirectory = QFileDialog::getExistingDirectory(this, "Save screenshots to");
+    if (outputDirectory.isEmpty()) return;
+
+    auto exporter = new LayoutScreenshotExporter(layoutFilePaths, layoutsDirectory, resolutions, outputDirectory, this);
+
+    // Modal, so that the project can't be closed or reloaded while exporting
+    auto progress = new QProgressDialog("Exporting layout screenshots...", "Cancel", 0, exporter->getTotalCount(), this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setAutoReset(false);
+    progress->setAutoClose(false);
+
+    connect(exporter, &LayoutScreenshotExporter::progressChanged, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, exporter, &LayoutScreenshotExporter::cancel);
+    connect(exporter, &LayoutScreenshotExporter::finished, this, [this, exporter, progress, outputDirectory]()
+    {
+        progress->deleteLater();
+        exporter->deleteLater();
+
+        const QStringList& errors = exporter->getErrors();
+        QMessageBox msgBox(errors.isEmpty() ? QMessageBox::Information : QMessageBox::Warning, "Export layout screenshots",
+                           QString("%1 of %2 screenshot(s) saved to '%3'").arg(exporter->getSavedCount())
+                                .arg(exporter->getTotalCount()).arg(outputDirectory),
+                           QMessageBox::Ok, this);
+        if (!errors.isEmpty()) msgBox.setDetailedText(errors.join('\n'));
+        msgBox.exec();
+    });
+
+    exporter->start();
+}
+
+// Shows the progress of the background project synchronisation, if any, and opens files
+// that were waiting for it when it succeeds
+void MainWindow::watchProjectSync()
+{
+    auto job = CEGUIManager::Instance().getSyncJob();
+    if (!job)
+    {
+        openFilesQueuedForSync();
+        return;
+    }
+
+    syncProgressBar->setValue(0);
+    syncProgressBar->setVisible(true);
+    syncCancelButton->setVisible(true);
+
+    connect(job, &CEGUIProjectSyncJob::progressChanged, this, [this](int value, int maximum, const QString& description)
+    {
+        syncProgressBar->setMaximum(maximum);
+        syncProgressBar->setValue(value);
+        if (!description.isEmpty()) statusBar()->showMessage(description);
+    });
+
+    // All CEGUI resources are destroyed right after a failure, tabs kept through a targeted reload can't
+    // outlive them. Their windows still exist here, so changes can be saved, but closing can't be cancelled.
+    connect(job, &CEGUIProjectSyncJob::failed, this, [this]()
+    {
+        closeAllTabsRequiringProject(true);
+    });
+
+    connect(job, &CEGUIProjectSyncJob::finished, this, [this](bool success)
+    {
+        syncProgressBar->setVisible(false);
+        syncCancelButton->setVisible(false);
+
+        if (success)
+        {
+            statusBar()->showMessage("Project resources loaded", 3000);
+            openFilesQueuedForSync();
+        }
+        else
+        {
+            statusBar()->showMessage("Loading of project resources was interrupted", 5000);
+            filesToOpenAfterSync.clear();
+        }
+    });
+}
+
+void MainWindow::openFilesQueuedForSync()
+{
+    const QStringList filePaths = filesToOpenAfterSync;
+    filesToOpenAfterSync.clear();
+
+    for (const auto& filePath : filePaths)
+    {
+        // Replace placeholders opened while resources were loading
+        auto it = std::find_if(activeEditors.begin(), activeEditors.end(), [&filePath](const EditorBasePtr& editor)
+        {
+            return editor->getFilePath() == filePath;
+        });
+        if (it != activeEditors.end() && dynamic_cast<NoEditor*>(it->get()))
+            closeEditorTab(it->get());
+
+        openEditorTab(filePath);
+    }
 }
 
 void MainWindow::on_actionNewLayout_triggered()
@@ -11,11 +11,14 @@ class MainWindow;
 }
 
 class ProjectManager;
+class CEGUIFrameScheduler;
 class FileSystemBrowser;
 class UndoViewer;
 class SettingsDialog;
 class RecentlyUsedMenuEntry;
 class CEGUIProject;
+class QProgressBar;
+class QToolButton;
 typedef std::unique_ptr<class EditorBase> EditorBasePtr;
 typedef std::unique_ptr<class EditorFactoryBase> EditorFactoryBasePtr;
 
@@ -48,6 +51,8 @@ public:
     QWidget* allocateOpenGLWidget();
     void freeOpenGLWidget(QWidget* widget);
 
+    CEGUIFrameScheduler* getFrameScheduler() const { return frameScheduler; }
+
 private slots:
 
     void openEditorTab(const QString& absolutePath);
@@ -101,6 +106,7 @@ private slots:
     void on_actionSaveProject_triggered();
     bool on_actionCloseProject_triggered();
     void on_actionReloadResources_triggered();
+    void on_actionExportLayoutScreenshots_triggered();
     void on_actionNewLayout_triggered();
     void on_actionNewImageset_triggered();
     void on_actionNewOtherFile_triggered();
@@ -120,7 +126,9 @@ private:
     EditorBasePtr createEditorForFile(const QString& absolutePath);
     bool activateEditorTabByFilePath(const QString& absolutePath);
     void closeEditorTab(EditorBase* editor);
-    bool closeAllTabsRequiringProject();
+    bool closeAllTabsRequiringProject(bool force = false);
+    void watchProjectSync();
+    void openFilesQueuedForSync();
     EditorBase* getEditorForTab(int index) const;
     EditorBase* getEditorForTab(QWidget* tabWidget) const;
 
@@ -131,10 +139,14 @@ private:
     UndoViewer* undoViewer = nullptr;
     QDockWidget* propertyDockWidget = nullptr;
     SettingsDialog* settingsDialog = nullptr;
+    CEGUIFrameScheduler* frameScheduler = nullptr;
     RecentlyUsedMenuEntry* recentlyUsedFiles = nullptr;
     RecentlyUsedMenuEntry* recentlyUsedProjects = nullptr;
     QMenu* docsToolbarsMenu = nullptr;
     QAction* tabsMenuSeparator = nullptr;
+    QProgressBar* syncProgressBar = nullptr;
+    QToolButton* syncCancelButton = nullptr;
+    QStringList filesToOpenAfterSync; // Project dependent files waiting for resources to load
 
     bool wasMaximizedBeforeFullscreen = false;
     bool displayingReloadAlert = false;
@@ -1,11 +1,14 @@
 #include "src/ui/ProjectManager.h"
 #include "src/cegui/CEGUIProject.h"
 #include "src/cegui/CEGUIProjectItem.h"
+#include "src/cegui/CEGUIManager.h"
 #include "ui_ProjectManager.h"
 #include "qinputdialog.h"
 #include "qfiledialog.h"
 #include "qmessagebox.h"
 #include "qmenu.h"
+#include "qdir.h"
+#include "qfileinfo.h"
 
 ProjectManager::ProjectManager(QWidget *parent) :
     QDockWidget(parent),
@@ -24,6 +27,9 @@ ProjectManager::ProjectManager(QWidget *parent) :
     _contextMenu->addSeparator();
     _contextMenu->addAction(ui->actionRename);
     _contextMenu->addAction(ui->actionRemove);
+    _contextMenu->addSeparator();
+    _contextMenu->addAction(ui->actionFindUsages);
+    _contextMenu->addAction(ui->actionFindUnusedAssets);
 
     setProject(nullptr);
 }
@@ -65,6 +71,8 @@ void ProjectManager::on_view_customContextMenuRequested(const QPoint& pos)
     ui->actionExistingFiles->setEnabled(createElement);
     ui->actionRename->setEnabled(selectedIndices.size() == 1);
     ui->actionRemove->setEnabled(!selectedIndices.empty());
+    ui->actionFindUsages->setEnabled(selectedIndices.size() == 1 &&
+                                     CEGUIProjectItem::getItemType(selectedIndices[0]) == CEGUIProjectItem::Type::File);
 
     _contextMenu->exec(mapToGlobal(pos));
 }
@@ -322,3 +330,51 @@ void ProjectManager::on_actionRemove_triggered()
 
     ui->view->setUpdatesEnabled(true);
 }
+
+void ProjectManager::on_actionFindUsages_triggered()
+{
+    if (!_project) return;
+
+    auto selectedIndices = ui->view->selectionModel()->selectedIndexes();
+    if (selectedIndices.size() != 1) return;
+
+    const QString filePath = QDir::cleanPath(_project->getAbsolutePathOf(selectedIndices[0].data(Qt::UserRole + 2).toString()));
+
+    auto& dependencyGraph = CEGUIManager::Instance().getDependencyGraph();
+    if (!dependencyGraph.isReady())
+    {
+        QMessageBox::information(this, "Find usages", "Project files are not indexed yet, wait until project resources are loaded.");
+        return;
+    }
+
+    const QStringList usages = dependencyGraph.findUsages(filePath);
+    const QStringList schemes = dependencyGraph.getSupplyingSchemes(filePath);
+
+    QMessageBox msgBox(QMessageBox::Information, "Find usages",
+                       QString("'%1' is used by %2 file(s)").arg(QFileInfo(filePath).fileName()).arg(usages.size()),
+                       QMessageBox::Ok, this);
+
+    QString details = usages.join('\n');
+    if (!schemes.isEmpty())
+        details += "\n\nSupplied by schemes:\n" + schemes.join('\n');
+    msgBox.setDetailedText(details);
+    msgBox.exec();
+}
+
+void ProjectManager::on_actionFindUnusedAssets_triggered()
+{
+    auto& dependencyGraph = CEGUIManager::Instance().getDependencyGraph();
+    if (!dependencyGraph.isReady())
+    {
+        QMessageBox::information(this, "Find unused assets", "Project files are not indexed yet, wait until project resources are loaded.");
+        return;
+    }
+
+    const QStringList unusedAssets = dependencyGraph.findUnusedAssets();
+
+    QMessageBox msgBox(QMessageBox::Information, "Find unused assets",
+                       QString("%1 asset(s) are not used by any project layout").arg(unusedAssets.size()),
+                       QMessageBox::Ok, this);
+    msgBox.setDetailedText(unusedAssets.join('\n'));
+    msgBox.exec();
+}
@@ -42,6 +42,10 @@ private slots:
 
     void on_actionRemove_triggered();
 
+    void on_actionFindUsages_triggered();
+
+    void on_actionFindUnusedAssets_triggered();
+
 private:
 
     Ui::ProjectManager *ui;
@@ -72,9 +72,11 @@ void ResizableRectItem::setResizingEnabled(bool enabled)
 // FIXME: dangerous overloading!
 void ResizableRectItem::setRect(QRectF newRect)
 {
-    if (newRect != rect()) _handlesDirty = true;
+    const bool changed = (newRect != rect());
+    if (changed) _handlesDirty = true;
     QGraphicsRectItem::setRect(newRect);
     updateHandles();
+    if (changed) notifyRectChanged();
 }
 
 void ResizableRectItem::beginResizing(const QGraphicsItem& handle)
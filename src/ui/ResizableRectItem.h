@@ -50,6 +50,7 @@ public:
     virtual void notifyMoveStarted() {}
     virtual void notifyMoveProgress(QPointF /*newPos*/) {}
     virtual void notifyMoveFinished(QPointF /*newPos*/) {}
+    virtual void notifyRectChanged() {}
 
 protected:
 
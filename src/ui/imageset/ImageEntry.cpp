@@ -5,13 +5,15 @@
 #include "src/ui/imageset/ImagesetEditorDockWidget.h"
 #include "src/ui/MainWindow.h" // for status bar
 #include "src/util/Utils.h"
-#include "src/util/Settings.h"
+#include "src/util/SettingsHandle.h"
 #include "src/Application.h"
 #include "qstatusbar.h"
 #include "qdom.h"
 #include "qpainter.h"
 #include "qlistwidget.h"
 
+static SettingsHandle<bool> overlayImageLabels("imageset/visual/overlay_image_labels");
+
 ImageEntry::ImageEntry(QGraphicsItem* parent)
     : ResizableRectItem(parent)
 {
@@ -58,8 +60,7 @@ void ImageEntry::notifyResizeFinished(QPointF newPos, QSizeF newSize)
 {
     ResizableRectItem::notifyResizeFinished(newPos, newSize);
 
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    if (_mouseOver && settings->getEntryValue("imageset/visual/overlay_image_labels").toBool())
+    if (_mouseOver && overlayImageLabels.get())
     {
         // If mouse is over we show the label again when resizing finishes
         label->setVisible(true);
@@ -243,8 +244,7 @@ QVariant ImageEntry::itemChange(GraphicsItemChange change, const QVariant& value
     {
         if (value.toBool())
         {
-            auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-            if (settings->getEntryValue("imageset/visual/overlay_image_labels").toBool())
+            if (overlayImageLabels.get())
                 label->setVisible(true);
 
             ImagesetEntry* imagesetEntry = static_cast<ImagesetEntry*>(parentItem());
@@ -310,8 +310,7 @@ void ImageEntry::hoverEnterEvent(QGraphicsSceneHoverEvent* event)
 
     Application* app = qobject_cast<Application*>(qApp);
 
-    auto&& settings = app->getSettings();
-    if (settings->getEntryValue("imageset/visual/overlay_image_labels").toBool())
+    if (overlayImageLabels.get())
         label->setVisible(true);
 
     app->getMainWindow()->statusBar()->showMessage(QString("Image: '%1'\t\tXPos: %2, YPos: %3, Width: %4, Height: %5")
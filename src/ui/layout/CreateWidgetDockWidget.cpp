@@ -2,11 +2,21 @@
 #include "src/cegui/CEGUIManager.h"
 #include "ui_CreateWidgetDockWidget.h"
 
+static const int THUMBNAIL_WIDTH = 96;
+static const int THUMBNAIL_HEIGHT = 48;
+static const size_t THUMBNAIL_BATCH_SIZE = 16;
+
 CreateWidgetDockWidget::CreateWidgetDockWidget(QWidget *parent) :
     QDockWidget(parent),
     ui(new Ui::CreateWidgetDockWidget)
 {
     ui->setupUi(this);
+
+    // Zero interval means "when all pending events are processed", batches are rendered one by one in idle time
+    _thumbnailTimer.setSingleShot(true);
+    connect(&_thumbnailTimer, &QTimer::timeout, this, &CreateWidgetDockWidget::renderThumbnailBatch);
+
+    ui->tree->setIconSize(ui->thumbnailsBox->isChecked() ? QSize(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT) : QSize());
 }
 
 CreateWidgetDockWidget::~CreateWidgetDockWidget()
@@ -16,6 +26,7 @@ CreateWidgetDockWidget::~CreateWidgetDockWidget()
 
 void CreateWidgetDockWidget::populate()
 {
+    _pendingThumbnails.clear();
     ui->tree->clear();
 
     std::map<QString, QStringList> widgetsBySkin;
@@ -46,4 +57,114 @@ void CreateWidgetDockWidget::populate()
             skinItem->addChild(widgetItem);
         }
     }
+
+    if (ui->thumbnailsBox->isChecked()) queueThumbnails();
+}
+
+void CreateWidgetDockWidget::on_thumbnailsBox_toggled(bool checked)
+{
+    ui->tree->setIconSize(checked ? QSize(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT) : QSize());
+
+    if (checked)
+    {
+        queueThumbnails();
+    }
+    else
+    {
+        _thumbnailTimer.stop();
+        _pendingThumbnails.clear();
+        for (int i = 0; i < ui->tree->topLevelItemCount(); ++i)
+        {
+            auto skinItem = ui->tree->topLevelItem(i);
+            for (int j = 0; j < skinItem->childCount(); ++j)
+                skinItem->child(j)->setIcon(0, QIcon());
+        }
+    }
+}
+
+// Rendering stops while the dock is hidden and continues when it is shown again. Resources loaded
+// on demand meanwhile may allow rendering of thumbnails skipped before.
+void CreateWidgetDockWidget::showEvent(QShowEvent* event)
+{
+    QDockWidget::showEvent(event);
+
+    if (ui->thumbnailsBox->isChecked() && _thumbnailsLoadGeneration != CEGUIManager::Instance().getResourceLoadGeneration())
+        queueThumbnails(true);
+    else if (!_pendingThumbnails.empty())
+        _thumbnailTimer.start(0);
+}
+
+// Only skinned widgets get thumbnails, the same ones that have previews in tooltips
+void CreateWidgetDockWidget::queueThumbnails(bool missingOnly)
+{
+    _pendingThumbnails.clear();
+    _thumbnailsGeneration = CEGUIManager::Instance().getResourceGeneration();
+    _thumbnailsLoadGeneration = CEGUIManager::Instance().getResourceLoadGeneration();
+
+    for (int i = 0; i < ui->tree->topLevelItemCount(); ++i)
+    {
+        auto skinItem = ui->tree->topLevelItem(i);
+        for (int j = 0; j < skinItem->childCount(); ++j)
+        {
+            auto item = skinItem->child(j);
+            if (item->text(0) != "TabButton" && !(missingOnly && !item->icon(0).isNull()))
+                _pendingThumbnails.push_back(item);
+        }
+    }
+
+    if (!_pendingThumbnails.empty()) _thumbnailTimer.start(0);
+}
+
+// Items of expanded skins go first, so that what the user is looking at gets its thumbnails sooner
+void CreateWidgetDockWidget::renderThumbnailBatch()
+{
+    if (!isVisible() || _pendingThumbnails.empty()) return;
+
+    // Resources are incomplete during synchronisation, wait for it to finish
+    auto& ceguiManager = CEGUIManager::Instance();
+    if (ceguiManager.isSyncInProgress())
+    {
+        _thumbnailTimer.start(200);
+        return;
+    }
+
+    // Resources have changed, everything must be rendered again
+    if (_thumbnailsGeneration != ceguiManager.getResourceGeneration())
+    {
+        queueThumbnails();
+        return;
+    }
+
+    std::vector<QTreeWidgetItem*> batch;
+    for (auto it = _pendingThumbnails.begin(); it != _pendingThumbnails.end() && batch.size() < THUMBNAIL_BATCH_SIZE; )
+    {
+        if ((*it)->parent()->isExpanded())
+        {
+            batch.push_back(*it);
+            it = _pendingThumbnails.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    while (batch.size() < THUMBNAIL_BATCH_SIZE && !_pendingThumbnails.empty())
+    {
+        batch.push_back(_pendingThumbnails.front());
+        _pendingThumbnails.pop_front();
+    }
+
+    QStringList widgetTypes;
+    for (auto item : batch)
+        widgetTypes.append(item->parent()->text(0) + "/" + item->text(0));
+
+    // Types whose resources are loaded on demand and weren't needed yet get no thumbnail for now
+    const auto thumbnails = ceguiManager.getWidgetThumbnails(widgetTypes, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT);
+
+    for (size_t i = 0; i < batch.size(); ++i)
+        if (!thumbnails[i].isNull())
+            batch[i]->setIcon(0, QIcon(QPixmap::fromImage(thumbnails[i])));
+
+    if (!_pendingThumbnails.empty()) _thumbnailTimer.start(0);
 }
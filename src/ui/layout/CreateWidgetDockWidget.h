@@ -2,13 +2,18 @@
 #define CREATEWIDGETDOCKWIDGET_H
 
 #include <QDockWidget>
+#include "qtimer.h"
+#include <deque>
 
-// This lists available widgets you can create and allows their creation (by drag N drop)
+// This lists available widgets you can create and allows their creation (by drag N drop).
+// Widget types may be shown with thumbnails, which are rendered in batches when the application is idle.
 
 namespace Ui {
 class CreateWidgetDockWidget;
 }
 
+class QTreeWidgetItem;
+
 class CreateWidgetDockWidget : public QDockWidget
 {
     Q_OBJECT
@@ -20,9 +25,23 @@ public:
 
     void populate();
 
+private slots:
+
+    void on_thumbnailsBox_toggled(bool checked);
+
 private:
 
+    virtual void showEvent(QShowEvent* event) override;
+
+    void queueThumbnails(bool missingOnly = false);
+    void renderThumbnailBatch();
+
     Ui::CreateWidgetDockWidget *ui;
+
+    QTimer _thumbnailTimer;
+    std::deque<QTreeWidgetItem*> _pendingThumbnails; // Items are owned by the tree and live until the next populate()
+    quint64 _thumbnailsGeneration = 0;
+    quint64 _thumbnailsLoadGeneration = 0; // Types with resources not loaded yet are retried when it changes
 };
 
 #endif // CREATEWIDGETDOCKWIDGET_H
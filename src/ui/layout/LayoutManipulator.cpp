@@ -5,7 +5,7 @@
 #include "src/editors/layout/LayoutVisualMode.h"
 #include "src/editors/layout/LayoutUndoCommands.h"
 #include "src/cegui/CEGUIUtils.h"
-#include "src/util/Settings.h"
+#include "src/util/SettingsHandle.h"
 #include "src/Application.h"
 #include <CEGUI/widgets/GridLayoutContainer.h>
 #include "QtnProperty/PropertySet.h"
@@ -18,6 +18,17 @@
 #include <qdrag.h>
 #include <qtimer.h>
 
+// Read on every paint and update from widget
+static SettingsHandle<QPen> normalOutline("layout/visual/normal_outline");
+static SettingsHandle<QPen> hoverOutline("layout/visual/hover_outline");
+static SettingsHandle<QPen> resizingOutline("layout/visual/resizing_outline");
+static SettingsHandle<QPen> movingOutline("layout/visual/moving_outline");
+static SettingsHandle<bool> preventOverlap("layout/visual/prevent_manipulator_overlap");
+static SettingsHandle<bool> autoWidgetsShowOutline("layout/visual/auto_widgets_show_outline");
+static SettingsHandle<bool> autoWidgetsSelectable("layout/visual/auto_widgets_selectable");
+static SettingsHandle<int> snapGridX("layout/visual/snap_grid_x");
+static SettingsHandle<int> snapGridY("layout/visual/snap_grid_y");
+
 LayoutManipulator::LayoutManipulator(LayoutVisualMode& visualMode, QGraphicsItem* parent, CEGUI::Window* widget)
     : CEGUIManipulator(parent, widget)
     , _visualMode(visualMode)
@@ -170,13 +181,11 @@ void LayoutManipulator::updateFromWidget(bool callUpdate, bool updateAncestorLCs
     _resizeable = true;
     if (_widget->isAutoWindow())
     {
-        auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-
         // Don't show outlines unless instructed to do so
-        if (!settings->getEntryValue("layout/visual/auto_widgets_show_outline").toBool())
+        if (!autoWidgetsShowOutline.get())
             _showOutline = false;
 
-        if (!settings->getEntryValue("layout/visual/auto_widgets_selectable").toBool())
+        if (!autoWidgetsSelectable.get())
         {
             // Make this widget non-interactive
             currFlags |= ItemHasNoContents;
@@ -200,6 +209,12 @@ void LayoutManipulator::updateFromWidget(bool callUpdate, bool updateAncestorLCs
     _visualMode.getScene()->onManipulatorUpdatedFromWidget(this);
 }
 
+// Deferred and coalesced with other scheduled updates of the scene, see LayoutScene::flushManipulatorUpdates
+void LayoutManipulator::scheduleUpdateFromWidget(bool callUpdate, bool updateAncestorLCs)
+{
+    _visualMode.getScene()->scheduleManipulatorUpdate(this, callUpdate, updateAncestorLCs);
+}
+
 void LayoutManipulator::detach(bool detachWidget, bool destroyWidget, bool recursive)
 {
     const bool isRoot = (_visualMode.getScene()->getRootWidgetManipulator() == this);
@@ -219,8 +234,7 @@ void LayoutManipulator::detach(bool detachWidget, bool destroyWidget, bool recur
 
 bool LayoutManipulator::preventManipulatorOverlap() const
 {
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    return settings->getEntryValue("layout/visual/prevent_manipulator_overlap").toBool();
+    return preventOverlap.get();
 }
 
 bool LayoutManipulator::useAbsoluteCoordsForMove() const
@@ -452,6 +466,10 @@ QVariant LayoutManipulator::itemChange(QGraphicsItem::GraphicsItemChange change,
     {
         _visualMode.getScene()->onManipulatorRemoved(this);
     }
+    else if (change == ItemParentHasChanged)
+    {
+        _visualMode.getScene()->onManipulatorReparented(this);
+    }
 
     return CEGUIManipulator::itemChange(change, value);
 }
@@ -524,32 +542,29 @@ void LayoutManipulator::onPropertyChanged(const QtnPropertyBase* property, CEGUI
 void LayoutManipulator::onWidgetNameChanged()
 {
     CEGUIManipulator::onWidgetNameChanged();
+    _visualMode.getScene()->onManipulatorRenamed(this);
     if (_treeItem) _treeItem->refreshPathData();
     if (_lcHandle) _lcHandle->updateTooltip();
 }
 
 QPen LayoutManipulator::getNormalPen() const
 {
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    return _showOutline ? settings->getEntryValue("layout/visual/normal_outline").value<QPen>() : QPen(QColor(0, 0, 0, 0));
+    return _showOutline ? normalOutline.get() : QPen(QColor(0, 0, 0, 0));
 }
 
 QPen LayoutManipulator::getHoverPen() const
 {
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    return _showOutline ? settings->getEntryValue("layout/visual/hover_outline").value<QPen>() : QPen(QColor(0, 0, 0, 0));
+    return _showOutline ? hoverOutline.get() : QPen(QColor(0, 0, 0, 0));
 }
 
 QPen LayoutManipulator::getPenWhileResizing() const
 {
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    return settings->getEntryValue("layout/visual/resizing_outline").value<QPen>();
+    return resizingOutline.get();
 }
 
 QPen LayoutManipulator::getPenWhileMoving() const
 {
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    return settings->getEntryValue("layout/visual/moving_outline").value<QPen>();
+    return movingOutline.get();
 }
 
 void LayoutManipulator::impl_paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
@@ -579,9 +594,8 @@ qreal LayoutManipulator::snapXCoordToGrid(qreal x)
     const qreal xOffset = static_cast<qreal>(childRect.d_min.x) - scenePos().x();
 
     // Point is in local space
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    const int snapGridX = settings->getEntryValue("layout/visual/snap_grid_x").toInt();
-    return xOffset + round((x - xOffset) / snapGridX) * snapGridX;
+    const int gridX = snapGridX.get();
+    return xOffset + round((x - xOffset) / gridX) * gridX;
 }
 
 qreal LayoutManipulator::snapYCoordToGrid(qreal y)
@@ -591,7 +605,6 @@ qreal LayoutManipulator::snapYCoordToGrid(qreal y)
     const qreal yOffset = static_cast<qreal>(childRect.d_min.y) - scenePos().y();
 
     // Point is in local space
-    auto&& settings = qobject_cast<Application*>(qApp)->getSettings();
-    const int snapGridY = settings->getEntryValue("layout/visual/snap_grid_y").toInt();
-    return yOffset + round((y - yOffset) / snapGridY) * snapGridY;
+    const int gridY = snapGridY.get();
+    return yOffset + round((y - yOffset) / gridY) * gridY;
 }
@@ -30,6 +30,7 @@ public:
     virtual void notifyMoveFinished(QPointF newPos) override;
 
     virtual void updateFromWidget(bool callUpdate = false, bool updateAncestorLCs = false) override;
+    void scheduleUpdateFromWidget(bool callUpdate = false, bool updateAncestorLCs = false);
     virtual void detach(bool detachWidget = true, bool destroyWidget = true, bool recursive = true) override;
 
     virtual bool preventManipulatorOverlap() const override;
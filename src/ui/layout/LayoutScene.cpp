@@ -19,6 +19,7 @@
 #include "qtreeview.h"
 #include "qstandarditemmodel.h"
 #include <qmenu.h>
+#include <qtimer.h>
 #include <set>
 
 // For properties (may be incapsulated somewhere):
@@ -48,6 +49,76 @@ void LayoutScene::updateFromWidgets()
     if (rootManipulator) rootManipulator->updateFromWidget();
 }
 
+// Batch operations change many widgets, often inside the same layout container. Updating each of
+// them right away would relayout and update shared ancestors over and over again, so updates are
+// collected and performed once per event loop iteration, top-down.
+void LayoutScene::scheduleManipulatorUpdate(LayoutManipulator* manipulator, bool callUpdate, bool updateAncestorLCs)
+{
+    if (!manipulator) return;
+
+    auto& flags = _dirtyManipulators[manipulator];
+    flags.first = flags.first || callUpdate;
+    flags.second = flags.second || updateAncestorLCs;
+
+    if (!_manipulatorUpdateQueued)
+    {
+        _manipulatorUpdateQueued = true;
+        QTimer::singleShot(0, this, &LayoutScene::flushManipulatorUpdates);
+    }
+}
+
+// Undo commands call it directly when they are done, so that geometry is up to date when they return.
+// Updates scheduled within one command are still coalesced.
+void LayoutScene::flushManipulatorUpdates()
+{
+    _manipulatorUpdateQueued = false;
+    if (_dirtyManipulators.isEmpty()) return;
+
+    // Updates may schedule new ones, they go to the next pass
+    QHash<LayoutManipulator*, std::pair<bool, bool>> dirty;
+    std::swap(dirty, _dirtyManipulators);
+
+    // Resolve topmost ancestor LCs, they lay out and update everything inside them
+    QHash<LayoutManipulator*, bool> pending;
+    for (auto it = dirty.cbegin(); it != dirty.cend(); ++it)
+    {
+        LayoutManipulator* manipulator = it.key();
+        bool callUpdate = it.value().first;
+        if (it.value().second)
+        {
+            if (auto topmostLC = static_cast<LayoutManipulator*>(manipulator->getTopmostAncestorLC()))
+            {
+                manipulator = topmostLC;
+                callUpdate = true;
+            }
+        }
+
+        bool& pendingCallUpdate = pending[manipulator];
+        pendingCallUpdate = pendingCallUpdate || callUpdate;
+    }
+
+    // The update is recursive, so manipulators with a pending ancestor are covered by it
+    std::vector<std::pair<LayoutManipulator*, bool>> roots;
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it)
+    {
+        LayoutManipulator* topmostPendingAncestor = nullptr;
+        for (auto item = it.key()->parentItem(); item; item = item->parentItem())
+        {
+            auto ancestor = static_cast<LayoutManipulator*>(item);
+            if (pending.contains(ancestor)) topmostPendingAncestor = ancestor;
+        }
+
+        if (!topmostPendingAncestor)
+            roots.emplace_back(it.key(), it.value());
+        else if (it.value())
+            pending[topmostPendingAncestor] = true;
+    }
+
+    // Ancestors could receive callUpdate from descendants after being collected
+    for (auto& root : roots)
+        root.first->updateFromWidget(pending.value(root.first), false);
+}
+
 // Overridden to keep the manipulators in sync
 void LayoutScene::setCEGUIDisplaySize(float width, float height)
 {
@@ -65,6 +136,11 @@ void LayoutScene::setRootWidgetManipulator(LayoutManipulator* manipulator)
 
     if (_multiSet) _multiSet->clearChildProperties();
 
+    // Items are deleted by clear() without notifying us
+    _manipulatorsByPath.clear();
+    _manipulatorPaths.clear();
+    _dirtyManipulators.clear();
+
     clear();
 
     rootManipulator = manipulator;
@@ -78,6 +154,9 @@ void LayoutScene::setRootWidgetManipulator(LayoutManipulator* manipulator)
         rootManipulator->updateFromWidget(true);
         addItem(rootManipulator);
 
+        // After adding, because manipulators entering the scene are unindexed as if removed
+        indexManipulator(rootManipulator, true);
+
         createAnchorItems();
 
         Application* app = qobject_cast<Application*>(qApp);
@@ -105,17 +184,32 @@ LayoutManipulator* LayoutScene::getManipulatorByPath(const QString& widgetPath)
 {
     if (!rootManipulator || widgetPath.isEmpty()) return nullptr;
 
+    auto it = _manipulatorsByPath.find(widgetPath);
+    if (it != _manipulatorsByPath.end())
+    {
+        LayoutManipulator* manipulator = it.value();
+        if (manipulator->getWidgetPath() == widgetPath) return manipulator;
+
+        // Stale, the widget was renamed or moved without us being notified
+        unindexManipulator(manipulator);
+    }
+
+    LayoutManipulator* manipulator = nullptr;
     auto sepPos = widgetPath.indexOf('/');
     if (sepPos < 0)
     {
         assert(widgetPath == rootManipulator->getWidgetName());
-        return rootManipulator;
+        manipulator = rootManipulator;
     }
     else
     {
         assert(widgetPath.leftRef(sepPos) == rootManipulator->getWidgetName());
-        return dynamic_cast<LayoutManipulator*>(rootManipulator->getManipulatorByPath(widgetPath.mid(sepPos + 1)));
+        manipulator = dynamic_cast<LayoutManipulator*>(rootManipulator->getManipulatorByPath(widgetPath.mid(sepPos + 1)));
     }
+
+    if (manipulator) indexManipulator(manipulator, false);
+
+    return manipulator;
 }
 
 bool LayoutScene::deleteWidgetByPath(const QString& widgetPath)
@@ -125,7 +219,7 @@ bool LayoutScene::deleteWidgetByPath(const QString& widgetPath)
 
     auto mainWindow = qobject_cast<Application*>(qApp)->getMainWindow();
     auto propertyWidget = static_cast<QtnPropertyWidget*>(mainWindow->getPropertyDockWidget()->widget());
-    if (propertyWidget->propertySet() == manipulator->getPropertySet())
+    if (manipulator->hasPropertySet() && propertyWidget->propertySet() == manipulator->getPropertySet())
         propertyWidget->setPropertySet(nullptr);
     if (_multiSet)
         _multiSet->clearChildProperties();
@@ -137,7 +231,7 @@ bool LayoutScene::deleteWidgetByPath(const QString& widgetPath)
 
     // Mostly for the LC case, its area depends on the children
     if (parentManipulator)
-        parentManipulator->updateFromWidget(true, true);
+        parentManipulator->scheduleUpdateFromWidget(true, true);
 
     return true;
 }
@@ -164,6 +258,14 @@ void LayoutScene::updatePropertySet(const std::set<LayoutManipulator*>& selected
 
     disconnect(propertyWidget->propertyView(), &QtnPropertyView::beforePropertyEdited, this, &LayoutScene::onBeforePropertyEdited);
 
+    // The multiset references properties of other manipulators, whose property sets
+    // may be released as soon as they are not selected, so it must never outlive a selection
+    if (_multiSet && selectedWidgets.size() <= 1)
+    {
+        propertyWidget->setPropertySet(nullptr);
+        _multiSet->clearChildProperties();
+    }
+
     if (selectedWidgets.size() == 1)
     {
         auto selectedWidget = *selectedWidgets.begin();
@@ -446,6 +548,58 @@ void LayoutScene::selectParent()
 void LayoutScene::onManipulatorRemoved(LayoutManipulator* manipulator)
 {
     if (_anchorTarget == manipulator) _anchorTarget = nullptr;
+
+    // Children are removed from the scene one by one too, each of them gets here
+    unindexManipulator(manipulator);
+    _dirtyManipulators.remove(manipulator);
+}
+
+// Called on each update from the widget, so it must be cheap when the name is the same
+void LayoutScene::onManipulatorRenamed(LayoutManipulator* manipulator)
+{
+    auto it = _manipulatorPaths.find(manipulator);
+    if (it == _manipulatorPaths.end()) return;
+
+    const QString name = manipulator->getWidgetName();
+    const QString& path = it.value();
+    if (path.endsWith(name) && (path.size() == name.size() || path[path.size() - name.size() - 1] == '/')) return;
+
+    // Paths of all descendants have changed too
+    indexManipulator(manipulator, true);
+}
+
+void LayoutScene::onManipulatorReparented(LayoutManipulator* manipulator)
+{
+    if (_manipulatorPaths.contains(manipulator))
+        indexManipulator(manipulator, true);
+}
+
+void LayoutScene::indexManipulator(LayoutManipulator* manipulator, bool recursive) const
+{
+    unindexManipulator(manipulator);
+
+    const QString path = manipulator->getWidgetPath();
+    _manipulatorsByPath[path] = manipulator;
+    _manipulatorPaths.insert(manipulator, path);
+
+    if (!recursive) return;
+
+    for (QGraphicsItem* childItem : manipulator->childItems())
+        if (auto child = dynamic_cast<LayoutManipulator*>(childItem))
+            indexManipulator(child, true);
+}
+
+void LayoutScene::unindexManipulator(LayoutManipulator* manipulator) const
+{
+    auto it = _manipulatorPaths.find(manipulator);
+    if (it == _manipulatorPaths.end()) return;
+
+    // Another manipulator may already be indexed by this path
+    auto itByPath = _manipulatorsByPath.find(it.value());
+    if (itByPath != _manipulatorsByPath.end() && itByPath.value() == manipulator)
+        _manipulatorsByPath.erase(itByPath);
+
+    _manipulatorPaths.erase(it);
 }
 
 void LayoutScene::onManipulatorUpdatedFromWidget(LayoutManipulator* manipulator)
@@ -4,6 +4,7 @@
 #include "src/ui/CEGUIGraphicsScene.h"
 #include <CEGUI/HorizontalAlignment.h>
 #include <CEGUI/VerticalAlignment.h>
+#include "qhash.h"
 #include <set>
 
 // This scene contains all the manipulators users want to interact it. You can visualise it as the
@@ -28,6 +29,8 @@ public:
     virtual ~LayoutScene() override;
 
     void updateFromWidgets();
+    void scheduleManipulatorUpdate(LayoutManipulator* manipulator, bool callUpdate, bool updateAncestorLCs);
+    void flushManipulatorUpdates();
     virtual void setCEGUIDisplaySize(float width, float height) override;
 
     void setRootWidgetManipulator(LayoutManipulator* manipulator);
@@ -45,6 +48,8 @@ public:
     void ignoreSelectionChanges(bool ignore) { _ignoreSelectionChanges = ignore; }
 
     void onManipulatorRemoved(LayoutManipulator* manipulator);
+    void onManipulatorRenamed(LayoutManipulator* manipulator);
+    void onManipulatorReparented(LayoutManipulator* manipulator);
     void onManipulatorUpdatedFromWidget(LayoutManipulator* manipulator);
     void anchorHandleMoved(QGraphicsItem* item, QPointF& newPos, bool moveOpposite);
     void anchorHandleSelected(QGraphicsItem* item);
@@ -80,6 +85,8 @@ public slots:
 protected:
 
     void createAnchorItems();
+    void indexManipulator(LayoutManipulator* manipulator, bool recursive) const;
+    void unindexManipulator(LayoutManipulator* manipulator) const;
 
     virtual void dragEnterEvent(QGraphicsSceneDragDropEvent* event) override;
     virtual void dragLeaveEvent(QGraphicsSceneDragDropEvent* event) override;
@@ -93,6 +100,15 @@ protected:
     LayoutVisualMode& _visualMode;
     LayoutManipulator* rootManipulator = nullptr;
 
+    // Full widget path to manipulator. Filled on lookups and kept up to date on renaming, reparenting
+    // and removal, entries are verified before use anyway because widgets can be renamed behind our back.
+    mutable QHash<QString, LayoutManipulator*> _manipulatorsByPath;
+    mutable QHash<const LayoutManipulator*, QString> _manipulatorPaths;
+
+    // Manipulators to be updated from their widgets in one pass, with callUpdate and updateAncestorLCs flags
+    QHash<LayoutManipulator*, std::pair<bool, bool>> _dirtyManipulators;
+    bool _manipulatorUpdateQueued = false;
+
     QtnPropertySet* _multiSet = nullptr;
     size_t _multiChangeId = 0;
 
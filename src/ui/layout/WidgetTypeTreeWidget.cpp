@@ -41,12 +41,11 @@ bool WidgetTypeTreeWidget::viewportEvent(QEvent* event)
 {
     if (event->type() == QEvent::ToolTip)
     {
-        // TODO: The big question is whether to reuse cached previews or always render them again.
-        //       I always render them again for now to avoid all sorts of caching issues
-        //       (when scheme/looknfeel editing is in place, etc...)
+        // Tooltips are built again only when project resources change, previews are cached in the same way
+        const quint64 resourceGeneration = CEGUIManager::Instance().getResourceGeneration();
 
         auto item = itemAt(static_cast<QHelpEvent*>(event)->pos());
-        if (item && !item->childCount())
+        if (item && !item->childCount() && item->data(0, TooltipGenerationRole) != QVariant(resourceGeneration))
         {
             QString skin = item->parent() ? item->parent()->text(0) : "__no_skin__";
             QString widgetType = item->text(0);
@@ -79,6 +78,7 @@ bool WidgetTypeTreeWidget::viewportEvent(QEvent* event)
             }
 
             item->setToolTip(0, QString("<small>Drag to the layout to create!</small><br />%1").arg(tooltipText));
+            item->setData(0, TooltipGenerationRole, resourceGeneration);
         }
     }
 
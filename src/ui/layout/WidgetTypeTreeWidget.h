@@ -14,6 +14,8 @@ public:
 
 protected:
 
+    static constexpr int TooltipGenerationRole = Qt::UserRole + 1;
+
     virtual void startDrag(Qt::DropActions supportedActions) override;
     virtual bool viewportEvent(QEvent* event) override;
 };
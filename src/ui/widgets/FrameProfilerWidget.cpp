@@ -0,0 +1,98 @@
+#include "src/ui/widgets/FrameProfilerWidget.h"
+#include "src/cegui/CEGUIManager.h"
+#include "qpainter.h"
+#include <algorithm>
+
+static const QColor stageColours[CEGUIFrameProfiler::StageCount] =
+{
+    QColor(80, 160, 255),
+    QColor(255, 140, 40),
+    QColor(90, 200, 90),
+    QColor(220, 80, 200),
+    QColor(160, 160, 160)
+};
+
+FrameProfilerWidget::FrameProfilerWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(180);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+void FrameProfilerWidget::paintEvent(QPaintEvent* /*event*/)
+{
+    const auto& profiler = CEGUIManager::Instance().getFrameProfiler();
+    const auto& history = profiler.getHistory();
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    const int legendWidth = 220;
+    const QRect chartsRect(0, 0, std::max(1, width() - legendWidth), height());
+    const QRect cpuRect(chartsRect.left(), chartsRect.top(), chartsRect.width(), chartsRect.height() / 2 - 2);
+    const QRect gpuRect(chartsRect.left(), chartsRect.top() + chartsRect.height() / 2 + 2, chartsRect.width(), chartsRect.height() / 2 - 2);
+
+    // Common vertical scale for both charts, at least 1 ms so that idle frames don't look dramatic
+    qint64 maxFrameTime = 1000000;
+    qint64 cpuTotals[CEGUIFrameProfiler::StageCount] = {};
+    qint64 gpuTotals[CEGUIFrameProfiler::StageCount] = {};
+    for (const auto& frame : history)
+    {
+        qint64 cpuFrameTime = 0;
+        qint64 gpuFrameTime = 0;
+        for (int i = 0; i < CEGUIFrameProfiler::StageCount; ++i)
+        {
+            cpuFrameTime += frame.cpu[i];
+            gpuFrameTime += frame.gpu[i];
+            cpuTotals[i] += frame.cpu[i];
+            gpuTotals[i] += frame.gpu[i];
+        }
+        maxFrameTime = std::max(maxFrameTime, std::max(cpuFrameTime, gpuFrameTime));
+    }
+
+    auto drawChart = [&](const QRect& chartRect, bool gpu, const QString& title)
+    {
+        painter.setPen(palette().mid().color());
+        painter.drawRect(chartRect.adjusted(0, 0, -1, -1));
+
+        const qreal barWidth = static_cast<qreal>(chartRect.width()) / CEGUIFrameProfiler::HistorySize;
+        const qreal scale = static_cast<qreal>(chartRect.height() - 2) / maxFrameTime;
+
+        // Newest frames are on the right
+        qreal x = chartRect.right() - barWidth * history.size();
+        for (const auto& frame : history)
+        {
+            qreal y = chartRect.bottom();
+            for (int i = 0; i < CEGUIFrameProfiler::StageCount; ++i)
+            {
+                const qreal h = (gpu ? frame.gpu[i] : frame.cpu[i]) * scale;
+                if (h <= 0.0) continue;
+                painter.fillRect(QRectF(x, y - h, std::max(1.0, barWidth - 1.0), h), stageColours[i]);
+                y -= h;
+            }
+            x += barWidth;
+        }
+
+        painter.setPen(palette().text().color());
+        painter.drawText(chartRect.adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop, title);
+    };
+
+    drawChart(cpuRect, false, QString("CPU, scale %1 ms").arg(maxFrameTime / 1000000.0, 0, 'f', 2));
+    drawChart(gpuRect, true, profiler.hasGPUTimes() ? "GPU" : "GPU (no timer queries available)");
+
+    // Legend with average times per frame
+    const int frameCount = std::max(1, static_cast<int>(history.size()));
+    const QFontMetrics metrics(font());
+    int y = metrics.height();
+    painter.drawText(chartsRect.right() + 8, y, "Average per frame, CPU / GPU ms");
+    for (int i = 0; i < CEGUIFrameProfiler::StageCount; ++i)
+    {
+        y += metrics.height() + 4;
+        painter.fillRect(chartsRect.right() + 8, y - metrics.ascent(), 10, metrics.ascent(), stageColours[i]);
+        painter.setPen(palette().text().color());
+        painter.drawText(chartsRect.right() + 24, y, QString("%1: %2 / %3")
+                         .arg(CEGUIFrameProfiler::getStageName(static_cast<CEGUIFrameProfiler::Stage>(i)))
+                         .arg(cpuTotals[i] / 1000000.0 / frameCount, 0, 'f', 3)
+                         .arg(gpuTotals[i] / 1000000.0 / frameCount, 0, 'f', 3));
+    }
+}
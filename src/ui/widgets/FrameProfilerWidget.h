@@ -0,0 +1,20 @@
+#ifndef FRAMEPROFILERWIDGET_H
+#define FRAMEPROFILERWIDGET_H
+
+#include "qwidget.h"
+
+// Rolling histograms of CEGUI view frame times, one stacked bar per frame and one colour per stage.
+// CPU times are drawn above GPU times, the legend shows averages over the whole history.
+
+class FrameProfilerWidget : public QWidget
+{
+public:
+
+    FrameProfilerWidget(QWidget* parent = nullptr);
+
+protected:
+
+    virtual void paintEvent(QPaintEvent* event) override;
+};
+
+#endif // FRAMEPROFILERWIDGET_H
@@ -0,0 +1,25 @@
+#include "src/util/SettingsHandle.h"
+#include "src/util/Settings.h"
+#include "src/util/SettingsEntry.h"
+#include "src/Application.h"
+
+// Handles are often static and may outlive settings, a connection to a destroyed entry is already broken
+SettingsHandleBase::~SettingsHandleBase()
+{
+    QObject::disconnect(_connection);
+}
+
+// Reads the current value and subscribes to its changes, fails if the entry isn't created yet
+bool SettingsHandleBase::resolve(const std::function<void(const QVariant&)>& onValueChanged) const
+{
+    auto app = qobject_cast<Application*>(qApp);
+    if (!app || !app->getSettings()) return false;
+
+    SettingsEntry* entry = app->getSettings()->getEntry(_path);
+    if (!entry) return false;
+
+    onValueChanged(entry->value());
+    _connection = QObject::connect(entry, &SettingsEntry::valueChanged, onValueChanged);
+    _resolved = true;
+    return true;
+}
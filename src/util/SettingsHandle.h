@@ -0,0 +1,59 @@
+#ifndef SETTINGSHANDLE_H
+#define SETTINGSHANDLE_H
+
+#include "qvariant.h"
+#include "qobject.h"
+#include <functional>
+
+// Typed access to a single settings entry for code that reads it often, like painting. The entry
+// is found by path on the first access, then the converted value is cached and kept up to date
+// through SettingsEntry::valueChanged. Until the entry exists the fallback value is returned.
+
+class SettingsEntry;
+
+class SettingsHandleBase
+{
+public:
+
+    const QString& getPath() const { return _path; }
+
+protected:
+
+    explicit SettingsHandleBase(const QString& path) : _path(path) {}
+    ~SettingsHandleBase();
+
+    SettingsHandleBase(const SettingsHandleBase&) = delete;
+    SettingsHandleBase& operator =(const SettingsHandleBase&) = delete;
+
+    bool resolve(const std::function<void(const QVariant&)>& onValueChanged) const;
+
+    QString _path;
+    mutable QMetaObject::Connection _connection;
+    mutable bool _resolved = false;
+};
+
+template<typename T>
+class SettingsHandle : public SettingsHandleBase
+{
+public:
+
+    explicit SettingsHandle(const QString& path, const T& fallback = T())
+        : SettingsHandleBase(path)
+        , _value(fallback)
+    {
+    }
+
+    const T& get() const
+    {
+        if (!_resolved) resolve([this](const QVariant& value) { _value = value.value<T>(); });
+        return _value;
+    }
+
+    operator const T&() const { return get(); }
+
+protected:
+
+    mutable T _value;
+};
+
+#endif // SETTINGSHANDLE_H
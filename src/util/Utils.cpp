@@ -1,11 +1,13 @@
 #include "src/util/Utils.h"
 #include <qpainter.h>
+#include <qregularexpression.h>
 
 namespace Utils
 {
 
 // Small helper function that generates a brush usually seen in graphics editing tools. The checkerboard brush
-// that draws background seen when edited images are transparent.
+// that draws background seen when edited images are transparent. The texture is an image and not a pixmap,
+// so the brush can be used in worker threads.
 QBrush getCheckerboardBrush(int halfWidth, int halfHeight, QColor firstColour, QColor secondColour)
 {
     // Disallow too large half sizes to prevent crashes in QPainter and slowness in general
@@ -13,7 +15,7 @@ QBrush getCheckerboardBrush(int halfWidth, int halfHeight, QColor firstColour, Q
     halfHeight = std::min(halfHeight, 256);
 
     QBrush ret;
-    QPixmap texture(2 * halfWidth, 2 * halfHeight);
+    QImage texture(2 * halfWidth, 2 * halfHeight, QImage::Format_RGB32);
 
     // Render checker
     {
@@ -24,7 +26,7 @@ QBrush getCheckerboardBrush(int halfWidth, int halfHeight, QColor firstColour, Q
         painter.fillRect(0, halfHeight, halfWidth, halfHeight, secondColour);
     }
 
-    ret.setTexture(texture);
+    ret.setTextureImage(texture);
 
     return ret;
 }
@@ -38,4 +40,20 @@ void fillTransparencyWithChecker(QImage& image, int halfWidth, int halfHeight, Q
     painter.end();
 }
 
+// "WIDTHxHEIGHT" pairs separated by anything, clamped like in CEGUIWidget
+std::vector<QSize> parseResolutions(const QString& str)
+{
+    std::vector<QSize> resolutions;
+    QRegularExpression re("(\\d+)\\s*x\\s*(\\d+)");
+    auto it = re.globalMatch(str);
+    while (it.hasNext())
+    {
+        const auto match = it.next();
+        resolutions.emplace_back(std::max(1, std::min(4096, match.captured(1).toInt())),
+                                 std::max(1, std::min(4096, match.captured(2).toInt())));
+    }
+
+    return resolutions;
+}
+
 };
@@ -2,12 +2,15 @@
 #define UTILS_H
 
 #include "qbrush.h"
+#include "qsize.h"
+#include <vector>
 
 namespace Utils
 {
 
 QBrush getCheckerboardBrush(int halfWidth = 5, int halfHeight = 5, QColor firstColour = Qt::darkGray, QColor secondColour = Qt::gray);
 void fillTransparencyWithChecker(QImage& image, int halfWidth = 5, int halfHeight = 5, QColor firstColour = Qt::darkGray, QColor secondColour = Qt::gray);
+std::vector<QSize> parseResolutions(const QString& str);
 
 };
 